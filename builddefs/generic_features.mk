@@ -31,6 +31,7 @@ GENERIC_FEATURES = \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
+    LIGHTING_SYNC \
     PROGRAMMABLE_BUTTON \
     SECURE \
     SPACE_CADET \
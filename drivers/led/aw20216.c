@@ -140,7 +140,8 @@ void AW20216_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 
 void AW20216_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
+        // Clear the flag first, so changes made while the transfer is in flight are sent next time.
+        g_pwm_buffer_update_required[index] = false;
         AW20216_write(cs_pin, AW_PAGE_PWM, 0, g_pwm_buffer[index], AW_PWM_REGISTER_COUNT);
     }
-    g_pwm_buffer_update_required[index] = false;
 }
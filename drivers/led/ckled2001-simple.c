@@ -44,8 +44,8 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in CKLED2001_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[DRIVER_COUNT][192];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[DRIVER_COUNT][192];
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0}; // bit n set: bytes n*16 to n*16+15 need to be transferred
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -69,33 +69,40 @@ bool CKLED2001_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
-bool CKLED2001_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool CKLED2001_write_pwm_chunk(uint8_t addr, uint8_t *pwm_buffer, uint8_t chunk) {
     // Assumes PG1 is already selected.
-    // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (int i = 0; i < 192; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+15.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
-        }
+    uint8_t i                = chunk * 16;
+    g_twi_transfer_buffer[0] = i;
+    // Copy the data from i to i+15.
+    // Device will auto-increment register for data after the first byte
+    // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
+    for (int j = 0; j < 16; j++) {
+        g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
+    }
 
 #if CKLED2001_PERSISTENCE > 0
-        for (uint8_t i = 0; i < CKLED2001_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, CKLED2001_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
+    for (uint8_t i = 0; i < CKLED2001_PERSISTENCE; i++) {
         if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, CKLED2001_TIMEOUT) != 0) {
             return false;
         }
+    }
+#else
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, CKLED2001_TIMEOUT) != 0) {
+        return false;
+    }
 #endif
+    return true;
+}
+
+bool CKLED2001_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // Assumes PG1 is already selected.
+    // If any of the transactions fails function returns false.
+    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // g_twi_transfer_buffer[] is 20 bytes
+    for (uint8_t chunk = 0; chunk < 12; chunk++) {
+        if (!CKLED2001_write_pwm_chunk(addr, pwm_buffer, chunk)) {
+            return false;
+        }
     }
     return true;
 }
@@ -151,8 +158,11 @@ void CKLED2001_set_value(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         memcpy_P(&led, (&g_ckled2001_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.v]          = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        // Only mark the 16 byte transfer containing the register if the value actually changes
+        if (g_pwm_buffer[led.driver][led.v] != value) {
+            g_pwm_buffer[led.driver][led.v] = value;
+            g_pwm_buffer_dirty[led.driver] |= 1 << (led.v / 16);
+        }
     }
 }
 
@@ -179,16 +189,23 @@ void CKLED2001_set_led_control_register(uint8_t index, bool value) {
 }
 
 void CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    // Claim the dirty chunks first, so changes made while the transfer is in flight are sent next time.
+    uint16_t dirty            = g_pwm_buffer_dirty[index];
+    g_pwm_buffer_dirty[index] = 0;
+
+    if (dirty) {
         CKLED2001_write_register(addr, CONFIGURE_CMD_PAGE, LED_PWM_PAGE);
 
-        // If any of the transactions fail we risk writing dirty PG0,
-        // refresh page 0 just in case.
-        if (!CKLED2001_write_pwm_buffer(addr, g_pwm_buffer[index])) {
-            g_led_control_registers_update_required[index] = true;
+        // Only transfer the chunks that changed since the last update.
+        for (uint8_t chunk = 0; chunk < 12; chunk++) {
+            if ((dirty & (1 << chunk)) && !CKLED2001_write_pwm_chunk(addr, g_pwm_buffer[index], chunk)) {
+                // If any of the transactions fail we risk writing dirty PG0,
+                // refresh page 0 just in case.
+                g_led_control_registers_update_required[index] = true;
+                break;
+            }
         }
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void CKLED2001_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -195,6 +195,9 @@ void CKLED2001_set_led_control_register(uint8_t index, bool red, bool green, boo
 
 void CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
+        // Clear the flag first, so changes made while the transfer is in flight are sent next time.
+        g_pwm_buffer_update_required[index] = false;
+
         CKLED2001_write_register(addr, CONFIGURE_CMD_PAGE, LED_PWM_PAGE);
 
         // If any of the transactions fail we risk writing dirty PG0,
@@ -203,7 +206,6 @@ void CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index) {
             g_led_control_registers_update_required[index] = true;
         }
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void CKLED2001_update_led_control_registers(uint8_t addr, uint8_t index) {
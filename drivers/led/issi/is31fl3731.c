@@ -65,8 +65,8 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in IS31FL3731_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[DRIVER_COUNT][144];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[DRIVER_COUNT][144];
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0}; // bit n set: bytes n*16 to n*16+15 need to be transferred
 
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -98,30 +98,34 @@ void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static void IS31FL3731_write_pwm_chunk(uint8_t addr, uint8_t *pwm_buffer, uint8_t chunk) {
     // assumes bank is already selected
-
-    // transmit PWM registers in 9 transfers of 16 bytes
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // iterate over the pwm_buffer contents at 16 byte intervals
-    for (int i = 0; i < 144; i += 16) {
-        // set the first register, e.g. 0x24, 0x34, 0x44, etc.
-        g_twi_transfer_buffer[0] = 0x24 + i;
-        // copy the data from i to i+15
-        // device will auto-increment register for data after the first byte
-        // thus this sets registers 0x24-0x33, 0x34-0x43, etc. in one transfer
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
-        }
+    uint8_t i = chunk * 16;
+    // set the first register, e.g. 0x24, 0x34, 0x44, etc.
+    g_twi_transfer_buffer[0] = 0x24 + i;
+    // copy the data from i to i+15
+    // device will auto-increment register for data after the first byte
+    // thus this sets registers 0x24-0x33, 0x34-0x43, etc. in one transfer
+    for (int j = 0; j < 16; j++) {
+        g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
+    }
 
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
-        }
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+    }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+    i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
 #endif
+}
+
+void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // assumes bank is already selected
+
+    // transmit PWM registers in 9 transfers of 16 bytes
+    // g_twi_transfer_buffer[] is 20 bytes
+    for (uint8_t chunk = 0; chunk < 9; chunk++) {
+        IS31FL3731_write_pwm_chunk(addr, pwm_buffer, chunk);
     }
 }
 
@@ -180,16 +184,24 @@ void IS31FL3731_init(uint8_t addr) {
     IS31FL3731_write_register(addr, ISSI_COMMANDREGISTER, 0);
 }
 
+static inline void IS31FL3731_set_pwm(uint8_t driver, uint8_t reg, uint8_t value) {
+    // Subtract 0x24 to get the second index of g_pwm_buffer
+    uint8_t i = reg - 0x24;
+    // only mark the 16 byte transfer containing the register if the value actually changes
+    if (g_pwm_buffer[driver][i] != value) {
+        g_pwm_buffer[driver][i] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << (i / 16);
+    }
+}
+
 void IS31FL3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        // Subtract 0x24 to get the second index of g_pwm_buffer
-        g_pwm_buffer[led.driver][led.r - 0x24]   = red;
-        g_pwm_buffer[led.driver][led.g - 0x24]   = green;
-        g_pwm_buffer[led.driver][led.b - 0x24]   = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3731_set_pwm(led.driver, led.r, red);
+        IS31FL3731_set_pwm(led.driver, led.g, green);
+        IS31FL3731_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -230,10 +242,18 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
+    // claim the dirty chunks first, so changes made while the transfer is in flight are sent next time
+    uint16_t dirty            = g_pwm_buffer_dirty[index];
+    g_pwm_buffer_dirty[index] = 0;
+
+    if (dirty) {
+        // only transfer the chunks that changed since the last update
+        for (uint8_t chunk = 0; chunk < 9; chunk++) {
+            if (dirty & (1 << chunk)) {
+                IS31FL3731_write_pwm_chunk(addr, g_pwm_buffer[index], chunk);
+            }
+        }
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -83,8 +83,8 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in IS31FL3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[LED_DRIVER_COUNT][192];
-bool    g_pwm_buffer_update_required[LED_DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[LED_DRIVER_COUNT][192];
+uint16_t g_pwm_buffer_dirty[LED_DRIVER_COUNT] = {0}; // bit n set: bytes n*16 to n*16+15 need to be transferred
 
 /* There's probably a better way to init this... */
 #if LED_DRIVER_COUNT == 1
@@ -117,33 +117,40 @@ bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
-bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool IS31FL3733_write_pwm_chunk(uint8_t addr, uint8_t *pwm_buffer, uint8_t chunk) {
     // Assumes PG1 is already selected.
-    // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (int i = 0; i < 192; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+15.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
-        }
+    uint8_t i                = chunk * 16;
+    g_twi_transfer_buffer[0] = i;
+    // Copy the data from i to i+15.
+    // Device will auto-increment register for data after the first byte
+    // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
+    for (int j = 0; j < 16; j++) {
+        g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
+    }
 
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
         if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
             return false;
         }
+    }
+#else
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+        return false;
+    }
 #endif
+    return true;
+}
+
+bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // Assumes PG1 is already selected.
+    // If any of the transactions fails function returns false.
+    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // g_twi_transfer_buffer[] is 20 bytes
+    for (uint8_t chunk = 0; chunk < 12; chunk++) {
+        if (!IS31FL3733_write_pwm_chunk(addr, pwm_buffer, chunk)) {
+            return false;
+        }
     }
     return true;
 }
@@ -198,8 +205,11 @@ void IS31FL3733_set_value(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.v]          = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        // Only mark the 16 byte transfer containing the register if the value actually changes
+        if (g_pwm_buffer[led.driver][led.v] != value) {
+            g_pwm_buffer[led.driver][led.v] = value;
+            g_pwm_buffer_dirty[led.driver] |= 1 << (led.v / 16);
+        }
     }
 }
 
@@ -225,17 +235,24 @@ void IS31FL3733_set_led_control_register(uint8_t index, bool value) {
 }
 
 void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    // Claim the dirty chunks first, so changes made while the transfer is in flight are sent next time.
+    uint16_t dirty            = g_pwm_buffer_dirty[index];
+    g_pwm_buffer_dirty[index] = 0;
+
+    if (dirty) {
         // Firstly we need to unlock the command register and select PG1.
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
-        // If any of the transactions fail we risk writing dirty PG0,
-        // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
-            g_led_control_registers_update_required[index] = true;
+        // Only transfer the chunks that changed since the last update.
+        for (uint8_t chunk = 0; chunk < 12; chunk++) {
+            if ((dirty & (1 << chunk)) && !IS31FL3733_write_pwm_chunk(addr, g_pwm_buffer[index], chunk)) {
+                // If any of the transactions fail we risk writing dirty PG0,
+                // refresh page 0 just in case.
+                g_led_control_registers_update_required[index] = true;
+                break;
+            }
         }
-        g_pwm_buffer_update_required[index] = false;
     }
 }
 
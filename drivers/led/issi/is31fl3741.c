@@ -84,9 +84,9 @@ uint8_t g_twi_transfer_buffer[20] = {0xFF};
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in IS31FL3741_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT]        = {false};
-bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+uint32_t g_pwm_buffer_dirty[DRIVER_COUNT]                  = {0}; // bit n set: bytes n*18 to n*18+17 need to be transferred
+bool     g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
@@ -103,53 +103,60 @@ void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // unlock the command register and select PG2
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM0);
+// The PWM buffer is transferred in 20 chunks: 19 of 18 bytes, and the 9 left
+// because the total number is 351. Chunks 0-9 live in PG0, chunks 10-19 in PG1.
+#define ISSI_PWM_CHUNKS 20
+#define ISSI_PWM_CHUNK_PAGE(chunk) ((chunk) < 10 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1)
 
-    for (int i = 0; i < 342; i += 18) {
-        if (i == 180) {
-            // unlock the command register and select PG2
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM1);
-        }
+static bool IS31FL3741_write_pwm_chunk(uint8_t addr, uint8_t *pwm_buffer, uint8_t chunk) {
+    // assumes the page of the chunk is already selected
+    uint16_t i    = chunk * 18;
+    uint8_t  size = (chunk == ISSI_PWM_CHUNKS - 1) ? 9 : 18;
 
-        g_twi_transfer_buffer[0] = i % 180;
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
-
-#if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
-#endif
-    }
-
-    // transfer the left cause the total number is 351
-    g_twi_transfer_buffer[0] = 162;
-    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
+    g_twi_transfer_buffer[0] = i % 180;
+    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, size);
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, size + 1, ISSI_TIMEOUT) != 0) {
             return false;
         }
     }
 #else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, size + 1, ISSI_TIMEOUT) != 0) {
         return false;
     }
 #endif
+    return true;
+}
+
+static bool IS31FL3741_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint32_t chunks) {
+    uint8_t page = 0xFF;
+
+    for (uint8_t chunk = 0; chunk < ISSI_PWM_CHUNKS; chunk++) {
+        if (!(chunks & ((uint32_t)1 << chunk))) {
+            continue;
+        }
+
+        if (page != ISSI_PWM_CHUNK_PAGE(chunk)) {
+            // unlock the command register and select the PWM page
+            page = ISSI_PWM_CHUNK_PAGE(chunk);
+            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
+            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page);
+        }
+
+        if (!IS31FL3741_write_pwm_chunk(addr, pwm_buffer, chunk)) {
+            return false;
+        }
+    }
 
     return true;
 }
 
+bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    return IS31FL3741_write_pwm_chunks(addr, pwm_buffer, ((uint32_t)1 << ISSI_PWM_CHUNKS) - 1);
+}
+
 void IS31FL3741_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -177,15 +184,22 @@ void IS31FL3741_init(uint8_t addr) {
     wait_ms(10);
 }
 
+static inline void IS31FL3741_set_pwm(uint8_t driver, uint16_t reg, uint8_t value) {
+    // only mark the 18 byte transfer containing the register if the value actually changes
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= (uint32_t)1 << (reg / 18);
+    }
+}
+
 void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3741_set_pwm(led.driver, led.r, red);
+        IS31FL3741_set_pwm(led.driver, led.g, green);
+        IS31FL3741_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -221,19 +235,20 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        IS31FL3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
-    }
+    // claim the dirty chunks first, so changes made while the transfer is in flight are sent next time
+    uint32_t dirty            = g_pwm_buffer_dirty[index];
+    g_pwm_buffer_dirty[index] = 0;
 
-    g_pwm_buffer_update_required[index] = false;
+    if (dirty) {
+        // only transfer the chunks that changed since the last update
+        IS31FL3741_write_pwm_chunks(addr, g_pwm_buffer[index], dirty);
+    }
 }
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue) {
-    g_pwm_buffer[pled->driver][pled->r] = red;
-    g_pwm_buffer[pled->driver][pled->g] = green;
-    g_pwm_buffer[pled->driver][pled->b] = blue;
-
-    g_pwm_buffer_update_required[pled->driver] = true;
+    IS31FL3741_set_pwm(pled->driver, pled->r, red);
+    IS31FL3741_set_pwm(pled->driver, pled->g, green);
+    IS31FL3741_set_pwm(pled->driver, pled->b, blue);
 }
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
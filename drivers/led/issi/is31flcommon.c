@@ -36,8 +36,13 @@ uint8_t g_twi_transfer_buffer[20];
 
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
-uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// The PWM buffer is transferred in chunks of ISSI_PWM_TRF_SIZE bytes,
+// g_pwm_buffer_dirty tracks which of them changed since the last update.
+#define ISSI_PWM_CHUNKS ((ISSI_MAX_LEDS + ISSI_PWM_TRF_SIZE - 1) / ISSI_PWM_TRF_SIZE)
+_Static_assert(ISSI_PWM_CHUNKS <= 16, "Too many PWM transfers to track in g_pwm_buffer_dirty");
+
+uint8_t  g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0};
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
@@ -121,13 +126,28 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
 }
 
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    // Claim the dirty chunks first, so changes made while the transfer is in flight are sent next time
+    uint16_t dirty            = g_pwm_buffer_dirty[index];
+    g_pwm_buffer_dirty[index] = 0;
+
+    if (dirty) {
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
-        // Update flags that pwm_buffer has been updated
-        g_pwm_buffer_update_required[index] = false;
+        // Hand off each changed chunk to IS31FL_write_multi_registers
+        for (uint8_t chunk = 0; chunk < ISSI_PWM_CHUNKS; chunk++) {
+            if (dirty & (1 << chunk)) {
+                uint8_t offset = chunk * ISSI_PWM_TRF_SIZE;
+                IS31FL_write_multi_registers(addr, g_pwm_buffer[index] + offset, ISSI_PWM_TRF_SIZE, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST + offset);
+            }
+        }
+    }
+}
+
+// Only mark the chunk containing the register if the value actually changes
+static inline void IS31FL_set_pwm(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << (reg / ISSI_PWM_TRF_SIZE);
     }
 }
 
@@ -171,10 +191,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm(led.driver, led.r, red);
+        IS31FL_set_pwm(led.driver, led.g, green);
+        IS31FL_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -220,8 +239,7 @@ void IS31FL_simple_set_scaling_buffer(uint8_t index, bool value) {
 void IS31FL_simple_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm(led.driver, led.v, value);
     }
 }
 
@@ -332,3 +332,15 @@ uint8_t oled_max_chars(void);
 
 // Returns the maximum number of lines that will fit on the oled
 uint8_t oled_max_lines(void);
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_BUFFER_ENABLE)
+// Split buffer sync, master side: copies the next block that changed since it
+// was last read into data (OLED_BLOCK_SIZE bytes), returns false if none did
+bool oled_split_read_block(uint8_t *block, uint8_t *data);
+
+// Split buffer sync, master side: flags a block to be read again, e.g. after a failed transfer
+void oled_split_mark_block(uint8_t block);
+
+// Split buffer sync, slave side: replaces a block of the buffer with the content sent by the master
+void oled_split_write_block(uint8_t block, const uint8_t *data);
+#endif
@@ -131,6 +131,9 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_BUFFER_ENABLE)
+OLED_BLOCK_TYPE oled_split_dirty = 0;
+#endif
 
 // Internal variables to reduce math instructions
 
@@ -293,6 +296,10 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
 void oled_render(void) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_BUFFER_ENABLE)
+    // Every change passes through here, so pick it up for the slave as well
+    oled_split_dirty |= oled_dirty;
+#endif
     if (!oled_dirty || !oled_initialized || oled_scrolling) {
         return;
     }
@@ -748,15 +755,24 @@ void oled_task(void) {
         return;
     }
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_BUFFER_ENABLE)
+    // The slave only displays the content pushed by the master
+    bool draw_content = is_keyboard_master();
+#else
+    bool draw_content = true;
+#endif
+
 #if OLED_UPDATE_INTERVAL > 0
-    if (timer_elapsed(oled_update_timeout) >= OLED_UPDATE_INTERVAL) {
+    if (draw_content && timer_elapsed(oled_update_timeout) >= OLED_UPDATE_INTERVAL) {
         oled_update_timeout = timer_read();
         oled_set_cursor(0, 0);
         oled_task_kb();
     }
 #else
-    oled_set_cursor(0, 0);
-    oled_task_kb();
+    if (draw_content) {
+        oled_set_cursor(0, 0);
+        oled_task_kb();
+    }
 #endif
 
 #if OLED_SCROLL_TIMEOUT > 0
@@ -787,6 +803,40 @@ void oled_task(void) {
 #endif
 }
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_BUFFER_ENABLE)
+bool oled_split_read_block(uint8_t *block, uint8_t *data) {
+    oled_split_dirty &= OLED_ALL_BLOCKS_MASK;
+    if (!oled_split_dirty) {
+        return false;
+    }
+
+    uint8_t index = 0;
+    while (!(oled_split_dirty & ((OLED_BLOCK_TYPE)1 << index))) {
+        ++index;
+    }
+    oled_split_dirty &= ~((OLED_BLOCK_TYPE)1 << index);
+
+    *block = index;
+    memcpy(data, &oled_buffer[OLED_BLOCK_SIZE * index], OLED_BLOCK_SIZE);
+    return true;
+}
+
+void oled_split_mark_block(uint8_t block) {
+    if (block < OLED_BLOCK_COUNT) {
+        oled_split_dirty |= ((OLED_BLOCK_TYPE)1 << block);
+    }
+}
+
+void oled_split_write_block(uint8_t block, const uint8_t *data) {
+    if (block >= OLED_BLOCK_COUNT) return;
+    uint8_t *dest = &oled_buffer[OLED_BLOCK_SIZE * block];
+    if (memcmp(dest, data, OLED_BLOCK_SIZE)) {
+        memcpy(dest, data, OLED_BLOCK_SIZE);
+        oled_dirty |= ((OLED_BLOCK_TYPE)1 << block);
+    }
+}
+#endif
+
 __attribute__((weak)) bool oled_task_kb(void) {
     return oled_task_user();
 }
@@ -5,6 +5,7 @@
 
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
+#    include "qp_draw.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
@@ -31,11 +32,18 @@ bool qp_comms_spi_start(painter_device_t device) {
 }
 
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
+    // Pixel data buffers are left alone until the next one is sent, so don't wait for them -- the next transfer, or
+    // stopping comms, waits instead
+    bool           async           = qp_internal_pixdata_can_send_async(data);
     uint32_t       bytes_remaining = byte_count;
     const uint8_t *p               = (const uint8_t *)data;
     while (bytes_remaining > 0) {
         uint32_t bytes_this_loop = bytes_remaining < 1024 ? bytes_remaining : 1024;
-        spi_transmit(p, bytes_this_loop);
+        if (async) {
+            spi_transmit_async(p, bytes_this_loop);
+        } else {
+            spi_transmit(p, bytes_this_loop);
+        }
         p += bytes_this_loop;
         bytes_remaining -= bytes_this_loop;
     }
@@ -98,6 +106,7 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     struct painter_driver_t *              driver       = (struct painter_driver_t *)device;
     struct qp_comms_spi_dc_reset_config_t *comms_config = (struct qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    spi_transmit_wait(); // pixel data may still be going out
     writePinLow(comms_config->dc_pin);
     spi_write(cmd);
 }
@@ -0,0 +1,180 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "color.h"
+#include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter surface configurables (add to your keyboard's config.h)
+
+#ifndef RGB565_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of RGB565 surface devices that Quantum Painter can use at any one time.
+ *      Increasing this number allows for multiple framebuffers to be used. Each requires its own RAM allocation.
+ */
+#    define RGB565_SURFACE_NUM_DEVICES 1
+#endif
+
+#ifndef RGB888_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of RGB888 surface devices that Quantum Painter can use at any one time.
+ */
+#    define RGB888_SURFACE_NUM_DEVICES 1
+#endif
+
+#ifndef MONO1BPP_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of 1bpp monochrome surface devices that Quantum Painter can use at any one time.
+ */
+#    define MONO1BPP_SURFACE_NUM_DEVICES 1
+#endif
+
+#ifndef GRAY4BPP_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of 4bpp grayscale surface devices that Quantum Painter can use at any one time.
+ */
+#    define GRAY4BPP_SURFACE_NUM_DEVICES 1
+#endif
+
+#ifndef PALETTE8BPP_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of 8bpp palette surface devices that Quantum Painter can use at any one time.
+ */
+#    define PALETTE8BPP_SURFACE_NUM_DEVICES 1
+#endif
+
+#ifndef QUANTUM_PAINTER_SURFACE_DIRTY_RECTS
+/**
+ * @def This controls the maximum number of separate dirty regions each surface keeps track of. Each region costs a
+ *      viewport command when transferring to the display, but areas which are far apart no longer need everything in
+ *      between them to be sent as well. When more regions are drawn to, the closest ones are merged together.
+ */
+#    define QUANTUM_PAINTER_SURFACE_DIRTY_RECTS 4
+#endif
+
+#ifndef QUANTUM_PAINTER_SURFACE_DIRTY_MERGE_SLACK
+/**
+ * @def Dirty regions are merged whenever the merged region would only add this many pixels which were not drawn to --
+ *      roughly the cost of the extra viewport command to send them separately.
+ */
+#    define QUANTUM_PAINTER_SURFACE_DIRTY_MERGE_SLACK 32
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+/**
+ * Factory method for an RGB565 surface (aka framebuffer).
+ *
+ * The surface can be transferred to displays with a native RGB565 pixel format.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `(sizeof(uint16_t) * panel_width * panel_height)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+
+/**
+ * Helper method to draw the dirty contents of the framebuffer to the target device.
+ *
+ * After successful completion, the dirty area is reset.
+ *
+ * @param surface[in] the surface to copy from
+ * @param display[in] the display to copy into
+ * @param x[in] the x-location of the original position of the framebuffer
+ * @param y[in] the y-location of the original position of the framebuffer
+ * @return whether the draw operation completed successfully
+ */
+bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y);
+#endif // QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+/**
+ * Factory method for an RGB888 surface.
+ *
+ * The surface can be transferred to displays with a native RGB888 pixel format.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `(3 * panel_width * panel_height)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_rgb888_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+#endif // QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+/**
+ * Factory method for a 1bpp monochrome surface.
+ *
+ * Pixels are black or white, and are converted to the native pixel format of the display they are transferred to.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `((panel_width * panel_height + 7) / 8)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_mono1bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+#endif // QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_GRAY4BPP_SURFACE_ENABLE
+/**
+ * Factory method for a 4bpp grayscale surface.
+ *
+ * Pixels are one of 16 levels of gray, and are converted to the native pixel format of the display they are
+ * transferred to.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `((panel_width * panel_height + 1) / 2)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_gray4bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+#endif // QUANTUM_PAINTER_GRAY4BPP_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_PALETTE8BPP_SURFACE_ENABLE
+/**
+ * Factory method for an 8bpp palette surface.
+ *
+ * Pixels are indices into the supplied palette, and are converted to the native pixel format of the display they are
+ * transferred to. Colors drawn to the surface are matched to the closest palette entry. Palettes of more than 16
+ * entries require `QUANTUM_PAINTER_SUPPORTS_256_PALETTE`.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `(panel_width * panel_height)`
+ * @param palette[in] the colors of the palette, which need to stay valid for as long as the surface is used
+ * @param palette_size[in] the number of colors in the palette
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_palette8bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer, const HSV *palette, uint16_t palette_size);
+#endif // QUANTUM_PAINTER_PALETTE8BPP_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+/**
+ * Helper method to draw the contents of the framebuffer to the target device.
+ *
+ * Only the dirty regions are transferred, unless `entire_surface` is set. After successful completion, the dirty
+ * regions are reset.
+ *
+ * @param surface[in] the surface to copy from
+ * @param display[in] the display to copy into
+ * @param x[in] the x-location of the original position of the framebuffer
+ * @param y[in] the y-location of the original position of the framebuffer
+ * @param entire_surface[in] whether the whole surface should be transferred, rather than just the dirty regions
+ * @return whether the draw operation completed successfully
+ */
+bool qp_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y, bool entire_surface);
+
+/**
+ * Sets the display that `qp_flush()` on the surface transfers the dirty regions to.
+ *
+ * @param surface[in] the surface to copy from
+ * @param display[in] the display to copy into, or NULL so that `qp_flush()` only resets the dirty regions
+ * @param x[in] the x-location of the framebuffer on the display
+ * @param y[in] the y-location of the framebuffer on the display
+ */
+void qp_surface_set_flush_target(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y);
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
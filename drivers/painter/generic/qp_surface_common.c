@@ -0,0 +1,400 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+#include "qp_comms.h"
+#include "qp_draw.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dirty region helpers
+
+static inline uint32_t rect_area(const surface_dirty_rect_t *rect) {
+    return (uint32_t)(rect->r - rect->l + 1) * (uint32_t)(rect->b - rect->t + 1);
+}
+
+static inline void rect_union(surface_dirty_rect_t *target, const surface_dirty_rect_t *a, const surface_dirty_rect_t *b) {
+    target->l = QP_MIN(a->l, b->l);
+    target->t = QP_MIN(a->t, b->t);
+    target->r = QP_MAX(a->r, b->r);
+    target->b = QP_MAX(a->b, b->b);
+}
+
+// Number of pixels a merged region would transfer without having been drawn to. Overlapping regions go negative, as the
+// overlap is no longer sent twice.
+static inline int32_t rect_merge_waste(const surface_dirty_rect_t *a, const surface_dirty_rect_t *b) {
+    surface_dirty_rect_t merged;
+    rect_union(&merged, a, b);
+    return (int32_t)rect_area(&merged) - (int32_t)rect_area(a) - (int32_t)rect_area(b);
+}
+
+static inline void remove_dirty_rect(surface_painter_device_t *surface, uint8_t index) {
+    surface->dirty[index] = surface->dirty[--surface->dirty_count];
+}
+
+static void add_dirty_rect(surface_painter_device_t *surface, surface_dirty_rect_t rect) {
+    while (true) {
+        // Absorb any regions which are cheap enough to send together with the new one
+        for (uint8_t i = 0; i < surface->dirty_count;) {
+            if (rect_merge_waste(&rect, &surface->dirty[i]) <= QUANTUM_PAINTER_SURFACE_DIRTY_MERGE_SLACK) {
+                rect_union(&rect, &rect, &surface->dirty[i]);
+                remove_dirty_rect(surface, i);
+                i = 0; // the grown region may now reach ones already checked
+            } else {
+                ++i;
+            }
+        }
+
+        if (surface->dirty_count < QUANTUM_PAINTER_SURFACE_DIRTY_RECTS) {
+            surface->dirty[surface->dirty_count++] = rect;
+            return;
+        }
+
+        // Out of regions -- merge the pair wasting the fewest pixels, with the new region as the last candidate
+        int32_t best_waste = INT32_MAX;
+        uint8_t best_a     = 0;
+        uint8_t best_b     = 0;
+        for (uint8_t a = 0; a < surface->dirty_count; ++a) {
+            for (uint8_t b = a + 1; b <= surface->dirty_count; ++b) {
+                int32_t waste = rect_merge_waste(&surface->dirty[a], (b == surface->dirty_count) ? &rect : &surface->dirty[b]);
+                if (waste < best_waste) {
+                    best_waste = waste;
+                    best_a     = a;
+                    best_b     = b;
+                }
+            }
+        }
+
+        if (best_b == surface->dirty_count) {
+            // Grow the new region, and go around again as it may now be cheap to merge with others
+            rect_union(&rect, &rect, &surface->dirty[best_a]);
+            remove_dirty_rect(surface, best_a);
+        } else {
+            // Combine two existing regions, freeing up a slot for the new one
+            rect_union(&surface->dirty[best_a], &surface->dirty[best_a], &surface->dirty[best_b]);
+            remove_dirty_rect(surface, best_b);
+        }
+    }
+}
+
+// Moves the area changed by the current viewport into the dirty regions
+static void commit_pending(surface_painter_device_t *surface) {
+    if (surface->is_pending) {
+        surface->is_pending = false;
+        add_dirty_rect(surface, surface->pending);
+    }
+}
+
+static inline void reset_dirty(surface_painter_device_t *surface) {
+    surface->is_pending  = false;
+    surface->dirty_count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pixel streaming helpers
+
+static inline void increment_pixdata_location(surface_painter_device_t *surface) {
+    // Increment the X-position
+    surface->pixdata_x++;
+
+    // If the x-coord has gone past the right-side edge, loop it back around and increment the y-coord
+    if (surface->pixdata_x > surface->viewport_r) {
+        surface->pixdata_x = surface->viewport_l;
+        surface->pixdata_y++;
+    }
+
+    // If the y-coord has gone past the bottom, loop it back to the top
+    if (surface->pixdata_y > surface->viewport_b) {
+        surface->pixdata_y = surface->viewport_t;
+    }
+}
+
+static inline void setpixel(surface_painter_device_t *surface, uint16_t x, uint16_t y, uint32_t value) {
+    uint8_t  bpp   = surface->base.native_bits_per_pixel;
+    uint32_t index = (uint32_t)y * surface->base.panel_width + x;
+
+    // Skip messing with the dirty info if the original value already matches
+    if (qp_surface_get_native_pixel(surface->buffer, bpp, index) != value) {
+        // Maintain the pending region
+        if (!surface->is_pending) {
+            surface->pending    = (surface_dirty_rect_t){.l = x, .t = y, .r = x, .b = y};
+            surface->is_pending = true;
+        } else {
+            if (surface->pending.l > x) {
+                surface->pending.l = x;
+            }
+            if (surface->pending.r < x) {
+                surface->pending.r = x;
+            }
+            if (surface->pending.t > y) {
+                surface->pending.t = y;
+            }
+            if (surface->pending.b < y) {
+                surface->pending.b = y;
+            }
+        }
+
+        // Update the pixel data in the buffer
+        qp_surface_set_native_pixel(surface->buffer, bpp, index, value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Transfer of the surface contents to another device
+
+// Sends the supplied region, with the display's comms already started
+static bool stream_rect(surface_painter_device_t *surface, painter_device_t display, uint16_t x, uint16_t y, const surface_dirty_rect_t *rect) {
+    struct painter_driver_t *display_driver = (struct painter_driver_t *)display;
+    uint8_t                  bpp            = surface->base.native_bits_per_pixel;
+
+    if (!display_driver->driver_vtable->viewport(display, x + rect->l, y + rect->t, x + rect->r, y + rect->b)) {
+        return false;
+    }
+
+    uint32_t total_pixel_count = qp_internal_num_pixels_in_buffer(display);
+    uint32_t pixel_counter     = 0;
+    for (uint16_t py = rect->t; py <= rect->b; ++py) {
+        uint32_t row_index = (uint32_t)py * surface->base.panel_width;
+        uint16_t px        = rect->l;
+        while (px <= rect->r) {
+            uint32_t count = QP_MIN((uint32_t)(rect->r - px + 1), total_pixel_count - pixel_counter);
+            if (surface->palette) {
+                // Indexed pixels are converted through the display's own palette
+                uint8_t indices[16];
+                count = QP_MIN(count, sizeof(indices));
+                for (uint32_t i = 0; i < count; ++i) {
+                    indices[i] = qp_surface_get_native_pixel(surface->buffer, bpp, row_index + px + i);
+                }
+                if (!display_driver->driver_vtable->append_pixels(display, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_counter, count, indices)) {
+                    return false;
+                }
+            } else {
+                // Native pixels already match the display, and are whole bytes
+                memcpy(&qp_internal_global_pixdata_buffer[pixel_counter * bpp / 8], &surface->buffer[(row_index + px) * bpp / 8], count * bpp / 8);
+            }
+            px += count;
+            pixel_counter += count;
+
+            // If we've accumulated enough data, send it
+            if (pixel_counter == total_pixel_count) {
+                if (!qp_internal_send_pixdata_buffer(display, pixel_counter)) {
+                    return false;
+                }
+                pixel_counter = 0;
+            }
+        }
+    }
+
+    // If there's any leftover data, send it
+    if (pixel_counter > 0) {
+        return qp_internal_send_pixdata_buffer(display, pixel_counter);
+    }
+    return true;
+}
+
+static bool stream_surface(surface_painter_device_t *surface, painter_device_t display, uint16_t x, uint16_t y, bool entire_surface) {
+    struct painter_driver_t *display_driver = (struct painter_driver_t *)display;
+    if (!display_driver->validate_ok) {
+        qp_dprintf("qp_surface_draw: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    commit_pending(surface);
+    if (!entire_surface && surface->dirty_count == 0) {
+        return true;
+    }
+
+    if (surface->palette) {
+        // Set up the lookup table for the display's pixel format
+        for (uint16_t i = 0; i < surface->palette_size; ++i) {
+            qp_internal_global_pixel_lookup_table[i] = (qp_pixel_t){.hsv888 = {.h = surface->palette[i].h, .s = surface->palette[i].s, .v = surface->palette[i].v}};
+        }
+        if (!display_driver->driver_vtable->palette_convert(display, surface->palette_size, qp_internal_global_pixel_lookup_table)) {
+            return false;
+        }
+    } else if (display_driver->native_bits_per_pixel != surface->base.native_bits_per_pixel) {
+        qp_dprintf("qp_surface_draw: fail (display pixel format does not match the surface)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(display)) {
+        qp_dprintf("qp_surface_draw: fail (could not start comms)\n");
+        return false;
+    }
+
+    bool ok = true;
+    if (entire_surface) {
+        surface_dirty_rect_t all = {.l = 0, .t = 0, .r = surface->base.panel_width - 1, .b = surface->base.panel_height - 1};
+        ok                       = stream_rect(surface, display, x, y, &all);
+    } else {
+        for (uint8_t i = 0; ok && i < surface->dirty_count; ++i) {
+            ok = stream_rect(surface, display, x, y, &surface->dirty[i]);
+        }
+    }
+    qp_comms_stop(display);
+
+    if (surface->palette) {
+        // The lookup table now holds the display's pixel format, so any cached palette is no longer valid
+        qp_internal_invalidate_palette();
+    }
+
+    if (ok) {
+        reset_dirty(surface);
+    }
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
+    struct painter_driver_t * driver  = (struct painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    memset(surface->buffer, 0, ((uint32_t)driver->panel_width * driver->panel_height * driver->native_bits_per_pixel + 7) / 8);
+
+    // Everything is now different to what the display last received
+    reset_dirty(surface);
+    add_dirty_rect(surface, (surface_dirty_rect_t){.l = 0, .t = 0, .r = driver->panel_width - 1, .b = driver->panel_height - 1});
+    return true;
+}
+
+bool qp_surface_power(painter_device_t device, bool power_on) {
+    // No-op.
+    return true;
+}
+
+bool qp_surface_clear(painter_device_t device) {
+    struct painter_driver_t *driver = (struct painter_driver_t *)device;
+    driver->driver_vtable->init(device, driver->rotation); // Re-init the surface
+    return true;
+}
+
+bool qp_surface_flush(painter_device_t device) {
+    struct painter_driver_t * driver  = (struct painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+
+    // Without a target, flushing only clears the dirty info
+    if (!surface->flush_target) {
+        reset_dirty(surface);
+        return true;
+    }
+    return stream_surface(surface, surface->flush_target, surface->flush_x, surface->flush_y, false);
+}
+
+bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    struct painter_driver_t * driver  = (struct painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+
+    // Drawing is moving elsewhere, so keep track of what the previous viewport changed
+    commit_pending(surface);
+
+    // Set the viewport locations
+    surface->viewport_l = left;
+    surface->viewport_t = top;
+    surface->viewport_r = right;
+    surface->viewport_b = bottom;
+
+    // Reset the write location to the top left
+    surface->pixdata_x = left;
+    surface->pixdata_y = top;
+    return true;
+}
+
+// Stream pixel data to the current write position in the buffer
+bool qp_surface_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    struct painter_driver_t * driver  = (struct painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    for (uint32_t pixel_counter = 0; pixel_counter < native_pixel_count; ++pixel_counter) {
+        setpixel(surface, surface->pixdata_x, surface->pixdata_y, qp_surface_get_native_pixel(pixel_data, driver->native_bits_per_pixel, pixel_counter));
+        increment_pixdata_location(surface);
+    }
+    return true;
+}
+
+// Append pixels to the target location, keyed by the pixel index
+bool qp_surface_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    struct painter_driver_t *driver = (struct painter_driver_t *)device;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        const qp_pixel_t *pixel = &palette[palette_indices[i]];
+        uint32_t          value;
+        switch (driver->native_bits_per_pixel) {
+            case 16:
+                value = pixel->rgb565;
+                break;
+            case 24:
+                value = ((uint32_t)pixel->rgb888.r) | ((uint32_t)pixel->rgb888.g << 8) | ((uint32_t)pixel->rgb888.b << 16);
+                break;
+            default:
+                value = pixel->palette_idx;
+                break;
+        }
+        qp_surface_set_native_pixel(target_buffer, driver->native_bits_per_pixel, pixel_offset + i, value);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Comms vtable
+
+static bool qp_surface_comms_init(painter_device_t device) {
+    // No-op.
+    return true;
+}
+static bool qp_surface_comms_start(painter_device_t device) {
+    // No-op.
+    return true;
+}
+static void qp_surface_comms_stop(painter_device_t device) {
+    // No-op.
+}
+static uint32_t qp_surface_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    // No-op.
+    return byte_count;
+}
+
+const struct painter_comms_vtable_t surface_driver_comms_vtable = {
+    // These are all effective no-op's because they're not actually needed.
+    .comms_init  = qp_surface_comms_init,
+    .comms_start = qp_surface_comms_start,
+    .comms_stop  = qp_surface_comms_stop,
+    .comms_send  = qp_surface_comms_send};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory helper for the per-format surfaces
+
+painter_device_t qp_surface_make_device(surface_painter_device_t *devices, uint8_t device_count, const struct painter_driver_vtable_t *driver_vtable, uint8_t bits_per_pixel, uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    for (uint8_t i = 0; i < device_count; ++i) {
+        surface_painter_device_t *driver = &devices[i];
+        if (!driver->base.driver_vtable) {
+            driver->base.driver_vtable         = driver_vtable;
+            driver->base.comms_vtable          = &surface_driver_comms_vtable;
+            driver->base.native_bits_per_pixel = bits_per_pixel;
+            driver->base.panel_width           = panel_width;
+            driver->base.panel_height          = panel_height;
+            driver->base.rotation              = QP_ROTATION_0;
+            driver->base.offset_x              = 0;
+            driver->base.offset_y              = 0;
+            driver->buffer                     = (uint8_t *)buffer;
+            return (painter_device_t)driver;
+        }
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Drawing routines to copy out the surface and send it to another device
+
+bool qp_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y, bool entire_surface) {
+    qp_dprintf("qp_surface_draw: entry\n");
+    struct painter_driver_t * surface_driver = (struct painter_driver_t *)surface;
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+    bool                      ret            = stream_surface(surface_handle, display, x, y, entire_surface);
+    qp_dprintf("qp_surface_draw: %s\n", ret ? "ok" : "fail");
+    return ret;
+}
+
+void qp_surface_set_flush_target(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
+    struct painter_driver_t * surface_driver = (struct painter_driver_t *)surface;
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+    surface_handle->flush_target             = display;
+    surface_handle->flush_x                  = x;
+    surface_handle->flush_y                  = y;
+}
@@ -0,0 +1,50 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+
+// Driver storage
+static surface_painter_device_t gray4bpp_surface_drivers[GRAY4BPP_SURFACE_NUM_DEVICES] = {0};
+
+// Colors of each pixel value, for conversion to the display's pixel format
+// clang-format off
+static const HSV gray4bpp_palette[16] = {
+    {0, 0,   0}, {0, 0,  17}, {0, 0,  34}, {0, 0,  51}, {0, 0,  68}, {0, 0,  85}, {0, 0, 102}, {0, 0, 119},
+    {0, 0, 136}, {0, 0, 153}, {0, 0, 170}, {0, 0, 187}, {0, 0, 204}, {0, 0, 221}, {0, 0, 238}, {0, 0, 255},
+};
+// clang-format on
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion, using the perceived brightness of the color
+static bool qp_gray4bpp_surface_palette_convert_gray4bpp(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB      rgb           = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        uint16_t luma          = (rgb.r * 77 + rgb.g * 150 + rgb.b * 29) >> 8;
+        palette[i].palette_idx = luma >> 4;
+    }
+    return true;
+}
+
+const struct painter_driver_vtable_t gray4bpp_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_gray4bpp_surface_palette_convert_gray4bpp,
+    .append_pixels   = qp_surface_append_pixels,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to a 4bpp grayscale surface
+
+painter_device_t qp_gray4bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    surface_painter_device_t *surface = (surface_painter_device_t *)qp_surface_make_device(gray4bpp_surface_drivers, GRAY4BPP_SURFACE_NUM_DEVICES, &gray4bpp_surface_driver_vtable, 4, panel_width, panel_height, buffer);
+    if (surface) {
+        surface->palette      = gray4bpp_palette;
+        surface->palette_size = 16;
+    }
+    return (painter_device_t)surface;
+}
@@ -0,0 +1,108 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "qp_surface.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Common
+
+// A rectangular region of the surface, inclusive of all edges
+typedef struct surface_dirty_rect_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} surface_dirty_rect_t;
+
+// Device definition
+typedef struct surface_painter_device_t {
+    struct painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
+
+    // The target buffer, with pixels in the native format packed row by row
+    uint8_t *buffer;
+
+    // Indexed surfaces store palette indices, which are converted to the native format of the display when drawing
+    const HSV *palette;
+    uint16_t   palette_size;
+
+    // Manually manage the viewport for streaming pixel data to the display
+    uint16_t viewport_l;
+    uint16_t viewport_t;
+    uint16_t viewport_r;
+    uint16_t viewport_b;
+
+    // Current write location to the display when streaming pixel data
+    uint16_t pixdata_x;
+    uint16_t pixdata_y;
+
+    // The area changed since the viewport was last set, merged into the dirty regions once drawing moves elsewhere
+    bool                 is_pending;
+    surface_dirty_rect_t pending;
+
+    // Maintain a list of dirty regions so we can stream only what we need
+    uint8_t              dirty_count;
+    surface_dirty_rect_t dirty[QUANTUM_PAINTER_SURFACE_DIRTY_RECTS];
+
+    // The display which qp_flush() transfers the dirty regions to
+    painter_device_t flush_target;
+    uint16_t         flush_x;
+    uint16_t         flush_y;
+} surface_painter_device_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Native pixel access -- sub-byte pixels are packed starting from the least significant bits
+
+static inline uint32_t qp_surface_get_native_pixel(const uint8_t *data, uint8_t bits_per_pixel, uint32_t index) {
+    switch (bits_per_pixel) {
+        case 1:
+            return (data[index / 8] >> (index % 8)) & 0x01;
+        case 4:
+            return (data[index / 2] >> ((index % 2) * 4)) & 0x0F;
+        case 8:
+            return data[index];
+        case 16:
+            return ((const uint16_t *)data)[index];
+        case 24:
+            return ((uint32_t)data[index * 3 + 0]) | ((uint32_t)data[index * 3 + 1] << 8) | ((uint32_t)data[index * 3 + 2] << 16);
+    }
+    return 0;
+}
+
+static inline void qp_surface_set_native_pixel(uint8_t *data, uint8_t bits_per_pixel, uint32_t index, uint32_t value) {
+    switch (bits_per_pixel) {
+        case 1:
+            data[index / 8] = (data[index / 8] & ~(0x01 << (index % 8))) | ((value & 0x01) << (index % 8));
+            break;
+        case 4:
+            data[index / 2] = (data[index / 2] & ~(0x0F << ((index % 2) * 4))) | ((value & 0x0F) << ((index % 2) * 4));
+            break;
+        case 8:
+            data[index] = value;
+            break;
+        case 16:
+            ((uint16_t *)data)[index] = value;
+            break;
+        case 24:
+            data[index * 3 + 0] = value;
+            data[index * 3 + 1] = value >> 8;
+            data[index * 3 + 2] = value >> 16;
+            break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Shared implementation, each pixel format supplies its own palette conversion and factory function
+
+bool qp_surface_init(painter_device_t device, painter_rotation_t rotation);
+bool qp_surface_power(painter_device_t device, bool power_on);
+bool qp_surface_clear(painter_device_t device);
+bool qp_surface_flush(painter_device_t device);
+bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+bool qp_surface_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+bool qp_surface_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices);
+
+extern const struct painter_comms_vtable_t surface_driver_comms_vtable;
+
+// Finds an unused device in the supplied storage, and sets it up
+painter_device_t qp_surface_make_device(surface_painter_device_t *devices, uint8_t device_count, const struct painter_driver_vtable_t *driver_vtable, uint8_t bits_per_pixel, uint16_t panel_width, uint16_t panel_height, void *buffer);
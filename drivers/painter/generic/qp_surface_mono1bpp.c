@@ -0,0 +1,43 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+
+// Driver storage
+static surface_painter_device_t mono1bpp_surface_drivers[MONO1BPP_SURFACE_NUM_DEVICES] = {0};
+
+// Colors of each pixel value, for conversion to the display's pixel format
+static const HSV mono1bpp_palette[2] = {{0, 0, 0}, {0, 0, 255}};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion
+static bool qp_mono1bpp_surface_palette_convert_mono1bpp(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        palette[i].mono = (palette[i].hsv888.v > 127) ? 1 : 0;
+    }
+    return true;
+}
+
+const struct painter_driver_vtable_t mono1bpp_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_mono1bpp_surface_palette_convert_mono1bpp,
+    .append_pixels   = qp_surface_append_pixels,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to a 1bpp monochrome surface
+
+painter_device_t qp_mono1bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    surface_painter_device_t *surface = (surface_painter_device_t *)qp_surface_make_device(mono1bpp_surface_drivers, MONO1BPP_SURFACE_NUM_DEVICES, &mono1bpp_surface_driver_vtable, 1, panel_width, panel_height, buffer);
+    if (surface) {
+        surface->palette      = mono1bpp_palette;
+        surface->palette_size = 2;
+    }
+    return (painter_device_t)surface;
+}
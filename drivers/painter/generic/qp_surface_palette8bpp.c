@@ -0,0 +1,69 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+#include "qp_draw.h"
+
+// Driver storage
+static surface_painter_device_t palette8bpp_surface_drivers[PALETTE8BPP_SURFACE_NUM_DEVICES] = {0};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion, picking the closest palette entry
+static bool qp_palette8bpp_surface_palette_convert_palette8bpp(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    struct painter_driver_t * driver  = (struct painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    for (int16_t i = 0; i < palette_size; ++i) {
+        HSV      hsv           = {palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v};
+        RGB      rgb           = hsv_to_rgb_nocie(hsv);
+        uint8_t  best_index    = 0;
+        uint32_t best_distance = UINT32_MAX;
+        for (uint16_t j = 0; j < surface->palette_size && best_distance > 0; ++j) {
+            const HSV *entry = &surface->palette[j];
+            if (entry->h == hsv.h && entry->s == hsv.s && entry->v == hsv.v) {
+                best_index = j;
+                break;
+            }
+            RGB      candidate = hsv_to_rgb_nocie(*entry);
+            int32_t  dr        = (int32_t)rgb.r - candidate.r;
+            int32_t  dg        = (int32_t)rgb.g - candidate.g;
+            int32_t  db        = (int32_t)rgb.b - candidate.b;
+            uint32_t distance  = dr * dr + dg * dg + db * db;
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_index    = j;
+            }
+        }
+        palette[i].palette_idx = best_index;
+    }
+    return true;
+}
+
+const struct painter_driver_vtable_t palette8bpp_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_palette8bpp_surface_palette_convert_palette8bpp,
+    .append_pixels   = qp_surface_append_pixels,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to an 8bpp palette surface
+
+painter_device_t qp_palette8bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer, const HSV *palette, uint16_t palette_size) {
+    // The palette is converted through the global lookup table when drawing to a display, so it has to fit
+    if (!palette || palette_size == 0 || palette_size > (sizeof(qp_internal_global_pixel_lookup_table) / sizeof(qp_internal_global_pixel_lookup_table[0]))) {
+        qp_dprintf("qp_palette8bpp_make_surface: fail (unsupported palette size)\n");
+        return NULL;
+    }
+
+    surface_painter_device_t *surface = (surface_painter_device_t *)qp_surface_make_device(palette8bpp_surface_drivers, PALETTE8BPP_SURFACE_NUM_DEVICES, &palette8bpp_surface_driver_vtable, 8, panel_width, panel_height, buffer);
+    if (surface) {
+        surface->palette      = palette;
+        surface->palette_size = palette_size;
+    }
+    return (painter_device_t)surface;
+}
@@ -0,0 +1,41 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+
+// Driver storage
+static surface_painter_device_t rgb565_surface_drivers[RGB565_SURFACE_NUM_DEVICES] = {0};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion
+static bool qp_rgb565_surface_palette_convert_rgb565_swapped(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB      rgb      = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        uint16_t rgb565   = (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+        palette[i].rgb565 = __builtin_bswap16(rgb565);
+    }
+    return true;
+}
+
+const struct painter_driver_vtable_t rgb565_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_rgb565_surface_palette_convert_rgb565_swapped,
+    .append_pixels   = qp_surface_append_pixels,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to an rgb565 surface
+
+painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    return qp_surface_make_device(rgb565_surface_drivers, RGB565_SURFACE_NUM_DEVICES, &rgb565_surface_driver_vtable, 16, panel_width, panel_height, buffer);
+}
+
+bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
+    return qp_surface_draw(surface, display, x, y, false);
+}
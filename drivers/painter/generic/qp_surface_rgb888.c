@@ -0,0 +1,38 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+
+// Driver storage
+static surface_painter_device_t rgb888_surface_drivers[RGB888_SURFACE_NUM_DEVICES] = {0};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion
+static bool qp_rgb888_surface_palette_convert_rgb888(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB rgb             = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        palette[i].rgb888.r = rgb.r;
+        palette[i].rgb888.g = rgb.g;
+        palette[i].rgb888.b = rgb.b;
+    }
+    return true;
+}
+
+const struct painter_driver_vtable_t rgb888_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_rgb888_surface_palette_convert_rgb888,
+    .append_pixels   = qp_surface_append_pixels,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to an rgb888 surface
+
+painter_device_t qp_rgb888_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    return qp_surface_make_device(rgb888_surface_drivers, RGB888_SURFACE_NUM_DEVICES, &rgb888_surface_driver_vtable, 24, panel_width, panel_height, buffer);
+}
@@ -74,3 +74,18 @@
  *         - Wait 50us to reset the LEDs
  */
 void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds);
+
+/* Asynchronous interface
+ *
+ * Converts the LED data and returns without waiting for the transfer, the
+ * caller may reuse ledarray right away. Backends that can transfer in the
+ * background keep one frame on the wire and queue the next one behind it; a
+ * newer frame replaces a frame that is still queued. The optional complete
+ * callback, which may run from an interrupt, is invoked once the frame has
+ * been sent, or from within the next call if the frame was replaced before
+ * reaching the wire. Backends without background transfers send synchronously
+ * and invoke the callback before returning.
+ */
+typedef void (*ws2812_complete_cb_t)(void);
+
+void ws2812_setleds_async(LED_TYPE *ledarray, uint16_t number_of_leds, ws2812_complete_cb_t complete);
@@ -72,7 +72,7 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
     uint8_t led_processed_count = 0;
     for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
         for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
-            if (led_processed_count == RGB_MATRIX_LED_PROCESS_LIMIT){
+            if (led_processed_count == RGB_MATRIX_LED_CHUNK_SIZE){
                 return;
             }
             uint8_t led_index = g_led_config.matrix_co[row][col];
@@ -0,0 +1,179 @@
+"""Functions that help us work with the QMK Audio Sample format, see platforms/chibios/drivers/audio_dac_sample.h
+"""
+import struct
+import wave
+from string import Template
+
+# The list of valid encodings, and their format byte in the header
+valid_formats = {
+    'pcm8': 0x00,
+    'pcm16': 0x01,
+    'adpcm': 0x02,
+}
+
+VERSION = 1
+
+# yapf: disable
+IMA_STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+IMA_INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8]
+# yapf: enable
+
+
+def read_wav(filename):
+    """Reads a PCM WAV file, and returns its sample rate and its samples mixed down to mono, as signed 16 bit values.
+    """
+    with wave.open(str(filename), 'rb') as wav:
+        channels = wav.getnchannels()
+        width = wav.getsampwidth()
+        rate = wav.getframerate()
+        frames = wav.readframes(wav.getnframes())
+
+    if width == 1:
+        values = [(b - 128) << 8 for b in frames]
+    elif width == 2:
+        values = list(struct.unpack('<%dh' % (len(frames) // 2), frames))
+    elif width == 3:
+        values = [int.from_bytes(frames[n + 1:n + 3], 'little', signed=True) for n in range(0, len(frames), 3)]
+    elif width == 4:
+        values = [v >> 16 for v in struct.unpack('<%di' % (len(frames) // 4), frames)]
+    else:
+        raise ValueError('Unsupported sample width of %d bytes' % width)
+
+    samples = [sum(values[n:n + channels]) // channels for n in range(0, len(values), channels)]
+    return rate, samples
+
+
+def resample(samples, rate, new_rate):
+    """Resamples by linear interpolation. Good enough for short keyboard sounds, down-sampling a lot calls for a low-pass filter first.
+    """
+    if rate == new_rate or not samples:
+        return samples
+
+    count = max(1, len(samples) * new_rate // rate)
+    resampled = []
+    for n in range(count):
+        position = n * rate / new_rate
+        index = int(position)
+        fraction = position - index
+        a = samples[min(index, len(samples) - 1)]
+        b = samples[min(index + 1, len(samples) - 1)]
+        resampled.append(int(round(a + (b - a) * fraction)))
+    return resampled
+
+
+def encode_adpcm(samples):
+    """Encodes to 4 bit IMA ADPCM, the first sample of each byte going into the low nibble.
+
+    Returns the initial predictor and step index, and the encoded bytes.
+    """
+    predictor = samples[0] if samples else 0
+    index = 0
+    initial = (predictor, index)
+    nibbles = []
+
+    for sample in samples:
+        step = IMA_STEP_TABLE[index]
+        diff = sample - predictor
+        code = 0
+        if diff < 0:
+            code = 8
+            diff = -diff
+
+        # mirror the decoder exactly, so the encoder tracks the value the keyboard will reconstruct
+        delta = step >> 3
+        if diff >= step:
+            code |= 4
+            diff -= step
+            delta += step
+        if diff >= step >> 1:
+            code |= 2
+            diff -= step >> 1
+            delta += step >> 1
+        if diff >= step >> 2:
+            code |= 1
+            delta += step >> 2
+
+        predictor += -delta if code & 8 else delta
+        predictor = max(-32768, min(32767, predictor))
+        index = max(0, min(88, index + IMA_INDEX_TABLE[code & 7]))
+        nibbles.append(code)
+
+    if len(nibbles) % 2:
+        nibbles.append(0)
+
+    data = bytes(nibbles[n] | (nibbles[n + 1] << 4) for n in range(0, len(nibbles), 2))
+    return initial, data
+
+
+def encode_sample(samples, rate, format):
+    """Encodes signed 16 bit samples into the QMK Audio Sample format, returning the bytes of the whole file.
+    """
+    predictor, index = 0, 0
+    if format == 'pcm8':
+        data = bytes((s >> 8) & 0xFF for s in samples)
+    elif format == 'pcm16':
+        data = struct.pack('<%dh' % len(samples), *samples)
+    elif format == 'adpcm':
+        (predictor, index), data = encode_adpcm(samples)
+    else:
+        raise ValueError('Unsupported format %s' % format)
+
+    header = b'QAS' + struct.pack('<BBBhII', VERSION, valid_formats[format], index, predictor, rate, len(samples))
+    return header + data
+
+
+license_template = """\
+// Copyright ${year} QMK -- generated source code only, audio retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `${generator_command}`
+"""
+
+header_file_template = """\
+${license}
+#pragma once
+
+#include <stdint.h>
+
+extern const uint32_t sample_${sane_name}_length;
+extern const uint8_t  sample_${sane_name}[${byte_count}];
+"""
+
+source_file_template = """\
+${license}
+#include <stdint.h>
+
+const uint32_t sample_${sane_name}_length = ${byte_count};
+
+// clang-format off
+const uint8_t sample_${sane_name}[${byte_count}] = {
+${bytes_lines}
+};
+// clang-format on
+"""
+
+
+def render_license(subs):
+    return Template(license_template).substitute(subs)
+
+
+def render_header(subs):
+    return Template(header_file_template).substitute(subs)
+
+
+def render_source(subs):
+    return Template(source_file_template).substitute(subs)
+
+
+def render_bytes(data, newline_after=16):
+    lines = []
+    for n in range(0, len(data), newline_after):
+        lines.append('    ' + ' '.join('0x{0:02X},'.format(b) for b in data[n:n + newline_after]))
+    return '\n'.join(lines)
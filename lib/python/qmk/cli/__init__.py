@@ -31,6 +31,7 @@ safe_commands = [
 ]
 
 subcommands = [
+    'qmk.cli.audio',
     'qmk.cli.bux',
     'qmk.cli.c2json',
     'qmk.cli.cd',
@@ -0,0 +1,86 @@
+"""Converts a WAV file into a sample the additive DAC audio driver can stream.
+"""
+import re
+import datetime
+from qmk.path import normpath
+from qmk.audio_sample import read_wav, resample, encode_sample, render_header, render_source, render_license, render_bytes, valid_formats
+from milc import cli
+
+
+@cli.argument('-i', '--input', required=True, help='Specify input WAV file.')
+@cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as input.')
+@cli.argument('-f', '--format', default='adpcm', help='Output format, valid types: %s' % (', '.join(valid_formats.keys())))
+@cli.argument('-r', '--rate', type=int, default=0, help='Resample to the given rate in Hz. Defaults to the rate of the input.')
+@cli.argument('-w', '--raw', arg_only=True, action='store_true', help='Writes out the QAS file as raw data instead of c/h combo, e.g. for writing to an external flash chip.')
+@cli.subcommand('Converts a WAV file to a sample QMK can play')
+def audio_convert_sample(cli):
+    """Converts a WAV file to the QMK Audio Sample format.
+
+    The sample is mixed down to mono and optionally resampled. The generated definitions are written to files next to the input -- `INPUT.qas.c` and `INPUT.qas.h`.
+    """
+    cli.args.input = normpath(cli.args.input)
+
+    # Error checking
+    if not cli.args.input.exists():
+        cli.log.error('Input WAV file does not exist!')
+        cli.print_usage()
+        return False
+
+    # Work out the output directory
+    if len(cli.args.output) == 0:
+        cli.args.output = cli.args.input.parent
+    cli.args.output = normpath(cli.args.output)
+
+    # Ensure we have a valid format
+    if cli.args.format not in valid_formats.keys():
+        cli.log.error('Output format %s is invalid. Allowed values: %s' % (cli.args.format, ', '.join(valid_formats.keys())))
+        cli.print_usage()
+        return False
+
+    # Load and encode the input
+    try:
+        rate, samples = read_wav(cli.args.input)
+    except Exception as e:
+        cli.log.error('Could not read %s: %s', cli.args.input, e)
+        return False
+
+    if not samples:
+        cli.log.error('Input WAV file is empty!')
+        return False
+
+    if cli.args.rate > 0:
+        samples = resample(samples, rate, cli.args.rate)
+        rate = cli.args.rate
+
+    out_bytes = encode_sample(samples, rate, cli.args.format)
+    cli.log.info('%d samples at %dHz, %d bytes encoded as %s', len(samples), rate, len(out_bytes), cli.args.format)
+
+    if cli.args.raw:
+        raw_file = cli.args.output / (cli.args.input.stem + ".qas")
+        with open(raw_file, 'wb') as raw:
+            raw.write(out_bytes)
+        return
+
+    # Work out the text substitutions for rendering the output data
+    subs = {
+        'generator_command': f'qmk audio-convert-sample -i {cli.args.input.name} -f {cli.args.format}',
+        'year': datetime.date.today().strftime("%Y"),
+        'sane_name': re.sub(r"[^a-zA-Z0-9]", "_", cli.args.input.stem),
+        'byte_count': len(out_bytes),
+        'bytes_lines': render_bytes(out_bytes),
+    }
+
+    # Render the license
+    subs.update({'license': render_license(subs)})
+
+    # Render and write the header file
+    header_file = cli.args.output / (cli.args.input.stem + ".qas.h")
+    with open(header_file, 'w') as header:
+        print(f"Writing {header_file}...")
+        header.write(render_header(subs))
+
+    # Render and write the source file
+    source_file = cli.args.output / (cli.args.input.stem + ".qas.c")
+    with open(source_file, 'w') as source:
+        print(f"Writing {source_file}...")
+        source.write(render_source(subs))
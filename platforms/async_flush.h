@@ -0,0 +1,26 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+
+typedef void (*async_flush_func_t)(void);
+
+#if defined(PLATFORM_SUPPORTS_SYNCHRONIZATION)
+bool async_flush_start(async_flush_func_t flush, async_flush_func_t complete);
+bool async_flush_in_flight(void);
+void async_flush_wait(void);
+#else
+/* Platforms without threads run the flush synchronously, so by the time
+ * async_flush_start() returns the transfer has already completed. */
+static inline bool async_flush_start(async_flush_func_t flush, async_flush_func_t complete) {
+    flush();
+    if (complete) complete();
+    return true;
+}
+static inline bool async_flush_in_flight(void) {
+    return false;
+}
+static inline void async_flush_wait(void) {}
+#endif
@@ -170,3 +170,10 @@ static inline void ws2812_sendarray_mask(uint8_t *data, uint16_t datlen, uint8_t
 
     SREG = sreg_prev;
 }
+
+void ws2812_setleds_async(LED_TYPE *ledarray, uint16_t leds, ws2812_complete_cb_t complete) {
+    ws2812_setleds(ledarray, leds);
+    if (complete) {
+        complete();
+    }
+}
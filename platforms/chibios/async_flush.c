@@ -0,0 +1,76 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "async_flush.h"
+#include "ch.h"
+
+#ifndef ASYNC_FLUSH_STACK_SIZE
+#    define ASYNC_FLUSH_STACK_SIZE 512
+#endif
+
+/* The flush thread runs above the main loop, so it gets the CPU back as soon
+ * as a transfer completes, queues the next one and sleeps again while the
+ * peripheral and DMA move the data. The main loop keeps scanning and
+ * rendering in between. */
+static THD_WORKING_AREA(waAsyncFlushThread, ASYNC_FLUSH_STACK_SIZE);
+static thread_t *         async_flush_thread = NULL;
+static binary_semaphore_t async_flush_request;
+static binary_semaphore_t async_flush_complete;
+
+static async_flush_func_t pending_flush;
+static async_flush_func_t pending_complete;
+static volatile bool      in_flight = false;
+
+static THD_FUNCTION(AsyncFlushThread, arg) {
+    (void)arg;
+    while (true) {
+        chBSemWait(&async_flush_request);
+        pending_flush();
+        if (pending_complete) {
+            pending_complete();
+        }
+        in_flight = false;
+        chBSemSignal(&async_flush_complete);
+    }
+}
+
+/**
+ * @brief Hand a flush function to the background thread. The optional complete
+ * callback is invoked from the flush thread once the flush function returns.
+ *
+ * @return false if the previous flush is still in flight
+ */
+bool async_flush_start(async_flush_func_t flush, async_flush_func_t complete) {
+    if (in_flight) {
+        return false;
+    }
+
+    if (async_flush_thread == NULL) {
+        chBSemObjectInit(&async_flush_request, true);
+        chBSemObjectInit(&async_flush_complete, true);
+        async_flush_thread = chThdCreateStatic(waAsyncFlushThread, sizeof(waAsyncFlushThread), NORMALPRIO + 1, AsyncFlushThread, NULL);
+    }
+
+    pending_flush    = flush;
+    pending_complete = complete;
+    in_flight        = true;
+    chBSemReset(&async_flush_complete, true);
+    chBSemSignal(&async_flush_request);
+    return true;
+}
+
+/**
+ * @brief Check whether a flush is still being executed by the background thread.
+ */
+bool async_flush_in_flight(void) {
+    return in_flight;
+}
+
+/**
+ * @brief Block until the flush currently in flight, if any, has completed.
+ */
+void async_flush_wait(void) {
+    while (in_flight) {
+        chBSemWait(&async_flush_complete);
+    }
+}
@@ -0,0 +1,287 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_dac_sample.h"
+#include <string.h>
+#ifdef FLASH_ENABLE
+#    include "flash_spi.h"
+#endif
+
+_Static_assert((AUDIO_SAMPLE_BUFFER_SIZE & (AUDIO_SAMPLE_BUFFER_SIZE - 1)) == 0 && AUDIO_SAMPLE_BUFFER_SIZE <= 32768, "AUDIO_SAMPLE_BUFFER_SIZE must be a power of two, up to 32768");
+
+#define POSITION_ONE (1UL << 16)
+
+// clang-format off
+static const int16_t ima_step_table[89] = {
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,
+       34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,   107,   118,   130,   143,
+      157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,   544,   598,   658,
+      724,   796,   876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
+     3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+static const int8_t ima_index_table[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+// clang-format on
+
+// reading the stored sample, from the main loop
+static audio_sample_read_t stream_read;
+static uint32_t            stream_address;   // next address to read from
+static uint32_t            stream_remaining; // encoded bytes left to read
+
+// encoded data, a single-producer/single-consumer ring buffer: 'audio_sample_task' only
+// ever writes 'stream_head', 'audio_sample_render' only ever writes 'stream_tail'
+static uint8_t           stream_buffer[AUDIO_SAMPLE_BUFFER_SIZE];
+static volatile uint16_t stream_head;
+static volatile uint16_t stream_tail;
+
+// decoding, from within the DAC interrupt
+static volatile bool playing = false;
+static uint8_t       format;
+static uint32_t      samples_remaining; // including the silence after the last sample
+static uint32_t      step;     // input samples per output sample, Q16
+static uint32_t      position; // between the previous and current input sample, Q16
+static int16_t       previous, current;
+static int32_t       predictor;
+static int8_t        step_index;
+static uint8_t       adpcm_byte;
+static bool          adpcm_high_nibble;
+
+static uint32_t output_rate_hz = 1;
+static uint8_t  gain           = 255;
+
+static const uint8_t *memory_sample; // the sample played by 'audio_sample_play'
+
+static inline uint16_t stream_available(void) {
+    return (uint16_t)(stream_head - stream_tail);
+}
+
+static inline uint8_t stream_pop(void) {
+    uint16_t tail = stream_tail;
+    uint8_t  byte = stream_buffer[tail & (AUDIO_SAMPLE_BUFFER_SIZE - 1)];
+    stream_tail   = tail + 1;
+    return byte;
+}
+
+/**
+ * Read as much of the stored sample as fits into the buffer.
+ *
+ * @return false on a read error
+ */
+static bool stream_fill(void) {
+    while (stream_remaining) {
+        uint16_t head   = stream_head;
+        uint16_t offset = head & (AUDIO_SAMPLE_BUFFER_SIZE - 1);
+        uint16_t length = AUDIO_SAMPLE_BUFFER_SIZE - stream_available();
+
+        // read up to the end of the ring, the next pass continues at its start
+        if (length > AUDIO_SAMPLE_BUFFER_SIZE - offset) {
+            length = AUDIO_SAMPLE_BUFFER_SIZE - offset;
+        }
+        if (length > stream_remaining) {
+            length = stream_remaining;
+        }
+        if (length == 0) {
+            break;
+        }
+
+        if (!stream_read(stream_address, &stream_buffer[offset], length)) {
+            stream_remaining = 0;
+            return false;
+        }
+        stream_address += length;
+        stream_remaining -= length;
+
+        // make sure the data is in place before the interrupt can see it
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+        stream_head = head + length;
+    }
+    return true;
+}
+
+static int16_t adpcm_decode(uint8_t code) {
+    int32_t ima_step = ima_step_table[step_index];
+    int32_t diff     = ima_step >> 3;
+
+    if (code & 4) diff += ima_step;
+    if (code & 2) diff += ima_step >> 1;
+    if (code & 1) diff += ima_step >> 2;
+
+    predictor += (code & 8) ? -diff : diff;
+    if (predictor > 32767) {
+        predictor = 32767;
+    } else if (predictor < -32768) {
+        predictor = -32768;
+    }
+
+    step_index += ima_index_table[code & 7];
+    if (step_index < 0) {
+        step_index = 0;
+    } else if (step_index > 88) {
+        step_index = 88;
+    }
+
+    return predictor;
+}
+
+/**
+ * Decode the next input sample, if the buffer holds enough data for it.
+ */
+static bool decode_next(int16_t *sample) {
+    switch (format) {
+        case AUDIO_SAMPLE_PCM8:
+            if (stream_available() < 1) return false;
+            *sample = (int16_t)((int8_t)stream_pop() * 256);
+            return true;
+        case AUDIO_SAMPLE_PCM16: {
+            if (stream_available() < 2) return false;
+            uint16_t low = stream_pop();
+            *sample      = (int16_t)(low | (stream_pop() << 8));
+            return true;
+        }
+        case AUDIO_SAMPLE_IMA_ADPCM:
+            if (adpcm_high_nibble) {
+                *sample = adpcm_decode(adpcm_byte >> 4);
+            } else {
+                if (stream_available() < 1) return false;
+                adpcm_byte = stream_pop();
+                *sample    = adpcm_decode(adpcm_byte & 0x0F);
+            }
+            adpcm_high_nibble = !adpcm_high_nibble;
+            return true;
+    }
+    return false;
+}
+
+void audio_sample_init(uint32_t output_rate) {
+    output_rate_hz = output_rate;
+}
+
+static uint32_t read_le(const uint8_t *bytes, uint8_t count) {
+    uint32_t value = 0;
+    for (uint8_t i = count; i > 0; i--) {
+        value = (value << 8) | bytes[i - 1];
+    }
+    return value;
+}
+
+bool audio_sample_play_from(audio_sample_read_t read, uint32_t address) {
+    uint8_t header[AUDIO_SAMPLE_HEADER_SIZE];
+
+    // stop the interrupt from decoding, before its state is changed
+    playing = false;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+    if (!read(address, header, sizeof(header))) {
+        return false;
+    }
+
+    uint32_t rate  = read_le(&header[8], 4);
+    uint32_t count = read_le(&header[12], 4);
+    if (memcmp(header, "QAS", 3) != 0 || header[3] != AUDIO_SAMPLE_VERSION || header[4] > AUDIO_SAMPLE_IMA_ADPCM || header[5] > 88 || rate == 0 || count == 0) {
+        return false;
+    }
+
+    format            = header[4];
+    step_index        = header[5];
+    predictor         = (int16_t)read_le(&header[6], 2);
+    adpcm_high_nibble = false;
+    samples_remaining = count + 1;
+    step              = (uint32_t)((((uint64_t)rate << 16) + output_rate_hz / 2) / output_rate_hz);
+    position          = 0;
+    previous          = 0;
+    current           = 0;
+
+    stream_read    = read;
+    stream_address = address + AUDIO_SAMPLE_HEADER_SIZE;
+    switch (format) {
+        case AUDIO_SAMPLE_PCM8:
+            stream_remaining = count;
+            break;
+        case AUDIO_SAMPLE_PCM16:
+            stream_remaining = count * 2;
+            break;
+        default:
+            stream_remaining = (count + 1) / 2;
+            break;
+    }
+    stream_head = 0;
+    stream_tail = 0;
+
+    if (!stream_fill()) {
+        return false;
+    }
+    playing = true;
+    audio_sample_start_output();
+    return true;
+}
+
+static bool audio_sample_read_memory(uint32_t address, void *buffer, uint16_t length) {
+    memcpy(buffer, memory_sample + address, length);
+    return true;
+}
+
+bool audio_sample_play(const uint8_t *sample) {
+    audio_sample_stop();
+    memory_sample = sample;
+    return audio_sample_play_from(audio_sample_read_memory, 0);
+}
+
+#ifdef FLASH_ENABLE
+static bool audio_sample_read_flash(uint32_t address, void *buffer, uint16_t length) {
+    return flash_read_block(address, buffer, length) == FLASH_STATUS_SUCCESS;
+}
+
+bool audio_sample_play_flash(uint32_t address) {
+    return audio_sample_play_from(audio_sample_read_flash, address);
+}
+#endif
+
+void audio_sample_stop(void) {
+    playing = false;
+}
+
+bool audio_sample_is_playing(void) {
+    return playing;
+}
+
+void audio_sample_set_gain(uint8_t level) {
+    gain = level;
+}
+
+void audio_sample_task(void) {
+    if (playing && !stream_fill()) {
+        playing = false;
+    }
+}
+
+int16_t audio_sample_render(void) {
+    if (!playing) {
+        return 0;
+    }
+
+    position += step;
+    while (position >= POSITION_ONE) {
+        if (samples_remaining == 0) {
+            playing = false;
+            return 0;
+        }
+
+        int16_t next = 0;
+        // the sample ends by interpolating to silence, rather than stopping on its last value
+        if (samples_remaining > 1 && !decode_next(&next)) {
+            // buffer underrun: hold the current value until the main loop has caught up
+            position = POSITION_ONE - 1;
+            break;
+        }
+        previous = current;
+        current  = next;
+        samples_remaining--;
+        position -= POSITION_ONE;
+    }
+
+    // linear interpolation between the two most recent input samples
+    int32_t sample = previous + (((int32_t)(current - previous) * (int32_t)(position >> 1)) >> 15);
+    return (sample * (gain + 1)) >> 8;
+}
+
+__attribute__((weak)) void audio_sample_start_output(void) {}
@@ -0,0 +1,116 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+  Streaming playback of recorded samples, mixed into the output of the additive DAC driver.
+
+  Samples are stored in the QMK Audio Sample format, as generated by
+  'qmk audio-convert-sample' - a 16 byte header followed by PCM or IMA ADPCM
+  encoded data:
+
+    offset  size  content
+         0     3  "QAS"
+         3     1  version, currently 1
+         4     1  audio_sample_format_t
+         5     1  IMA ADPCM: initial step index
+         6     2  IMA ADPCM: initial predictor, signed
+         8     4  sample rate, in Hz
+        12     4  number of samples
+
+  all values are little endian. The encoded data is read in small chunks from
+  the main loop ('audio_sample_task') into a ring buffer, and decoded one
+  sample at a time from within the DAC interrupt; so neither the whole
+  sample, nor its decoded form, need to fit into RAM - and samples can be
+  kept on an external SPI flash chip.
+
+  Nothing in here depends on ChibiOS, so the decoder can be run on the host -
+  see platforms/test/audio_dac_sample_tests.cpp.
+*/
+
+/**
+ * Size of the ring buffer holding encoded data, in bytes; a power of two.
+ * It needs to last for as long as the main loop can take between two calls
+ * to 'audio_sample_task': 256 bytes of ADPCM data are 512 samples, or ~23ms
+ * of a sample recorded at 22050Hz.
+ */
+#ifndef AUDIO_SAMPLE_BUFFER_SIZE
+#    define AUDIO_SAMPLE_BUFFER_SIZE 256
+#endif
+
+#define AUDIO_SAMPLE_HEADER_SIZE 16
+#define AUDIO_SAMPLE_VERSION 1
+
+typedef enum {
+    AUDIO_SAMPLE_PCM8,      // signed 8 bit
+    AUDIO_SAMPLE_PCM16,     // signed 16 bit, little endian
+    AUDIO_SAMPLE_IMA_ADPCM, // 4 bit IMA ADPCM, the first sample is in the low nibble
+} audio_sample_format_t;
+
+/**
+ * Reads 'length' bytes of a stored sample, starting at 'address'.
+ *
+ * @return false on a read error, which stops the playback
+ */
+typedef bool (*audio_sample_read_t)(uint32_t address, void *buffer, uint16_t length);
+
+/**
+ * @brief Set the rate at which 'audio_sample_render' is called, which samples are resampled to.
+ */
+void audio_sample_init(uint32_t output_rate);
+
+/**
+ * @brief Start playback of a sample, read through the given function.
+ *
+ * @details a sample already playing is replaced. Blocks while the header is
+ *          read and the buffer is filled for the first time.
+ *
+ * @param[in] read function to read the stored sample with
+ * @param[in] address start of the header, passed on to 'read'
+ * @return false if the header is not a valid sample
+ */
+bool audio_sample_play_from(audio_sample_read_t read, uint32_t address);
+
+/**
+ * @brief Start playback of a sample in memory, as generated by 'qmk audio-convert-sample'.
+ */
+bool audio_sample_play(const uint8_t *sample);
+
+#ifdef FLASH_ENABLE
+/**
+ * @brief Start playback of a sample stored at the given address of the external flash.
+ */
+bool audio_sample_play_flash(uint32_t address);
+#endif
+
+void audio_sample_stop(void);
+bool audio_sample_is_playing(void);
+
+/**
+ * @brief Set the playback level, 255 is full scale.
+ */
+void audio_sample_set_gain(uint8_t gain);
+
+/**
+ * @brief Refill the buffer from the stored sample; called from the main loop.
+ */
+void audio_sample_task(void);
+
+/**
+ * @brief Decode the next output sample.
+ *
+ * @details called at the output rate from within the DAC interrupt. Should the
+ *          buffer run dry, the last value is held until 'audio_sample_task'
+ *          has caught up.
+ * @return signed 16 bit sample; zero when nothing is playing
+ */
+int16_t audio_sample_render(void);
+
+/**
+ * @brief Called when playback starts, so the audio driver can turn its output on.
+ */
+void audio_sample_start_output(void);
@@ -0,0 +1,254 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_dac_synth.h"
+#include <stddef.h>
+
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define AUDIO_DAC_SYNTH_DEFAULT_WAVEFORM AUDIO_SYNTH_TRIANGLE
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define AUDIO_DAC_SYNTH_DEFAULT_WAVEFORM AUDIO_SYNTH_TRAPEZOID
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define AUDIO_DAC_SYNTH_DEFAULT_WAVEFORM AUDIO_SYNTH_SQUARE
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SAWTOOTH)
+#    define AUDIO_DAC_SYNTH_DEFAULT_WAVEFORM AUDIO_SYNTH_SAWTOOTH
+#else
+#    define AUDIO_DAC_SYNTH_DEFAULT_WAVEFORM AUDIO_SYNTH_SINE
+#endif
+
+#define ENVELOPE_FULL (1UL << 24)
+#define ENVELOPE_SUSTAIN ((uint32_t)AUDIO_DAC_ENVELOPE_SUSTAIN * ENVELOPE_FULL / 255)
+
+// clang-format off
+// One period of a sine wave in Q15, with the first sample repeated at the end for interpolation
+static const int16_t synth_sine[257] = {
+         0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+     12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,  18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+     23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+     30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+     32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,  32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+     30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+     23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+     12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,   6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+         0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804,
+         0,
+};
+// clang-format on
+
+static audio_synth_voice_t voices[AUDIO_DAC_SYNTH_VOICES];
+static uint32_t            sample_rate_hz;
+static uint32_t            attack_step, decay_step, release_step;
+static uint32_t            mix_gain; // Q16, follows 1/<number of sounding voices>
+
+static uint32_t envelope_step(uint32_t range, uint32_t time_ms) {
+    uint32_t samples = time_ms * sample_rate_hz / 1000;
+    return samples ? (range / samples) + 1 : range;
+}
+
+void audio_synth_init(uint32_t sample_rate) {
+    sample_rate_hz = sample_rate;
+    attack_step    = envelope_step(ENVELOPE_FULL, AUDIO_DAC_ENVELOPE_ATTACK_MS);
+    decay_step     = envelope_step(ENVELOPE_FULL - ENVELOPE_SUSTAIN, AUDIO_DAC_ENVELOPE_DECAY_MS);
+    release_step   = envelope_step(ENVELOPE_FULL, AUDIO_DAC_ENVELOPE_RELEASE_MS);
+    mix_gain       = 1UL << 16;
+
+    for (uint8_t i = 0; i < AUDIO_DAC_SYNTH_VOICES; i++) {
+        voices[i] = (audio_synth_voice_t){.waveform = AUDIO_DAC_SYNTH_DEFAULT_WAVEFORM, .gain = 255};
+    }
+}
+
+static uint32_t frequency_to_increment(float frequency) {
+    // 2^32 phase steps per period
+    return (uint32_t)(frequency * (4294967296.0f / sample_rate_hz));
+}
+
+static void voice_start(audio_synth_voice_t *voice, uint32_t increment) {
+    if (voice->stage == AUDIO_SYNTH_OFF) {
+        voice->phase = 0;
+    }
+    voice->increment = increment;
+    voice->stage     = AUDIO_SYNTH_ATTACK;
+}
+
+void audio_synth_set_frequencies(const float *frequencies, uint8_t count) {
+    uint32_t increments[AUDIO_DAC_SYNTH_VOICES];
+    uint8_t  pending = 0;
+    // voices that already have their (new) frequency assigned
+    bool claimed[AUDIO_DAC_SYNTH_VOICES] = {false};
+
+    for (uint8_t i = 0; i < count && pending < AUDIO_DAC_SYNTH_VOICES; i++) {
+        if (frequencies[i] > 0) {
+            increments[pending++] = frequency_to_increment(frequencies[i]);
+        }
+    }
+
+    // Keep voices that are already playing one of the frequencies
+    for (uint8_t i = 0; i < pending;) {
+        uint8_t v = 0;
+        for (; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+            if (!claimed[v] && voices[v].increment == increments[i] && voices[v].stage != AUDIO_SYNTH_OFF && voices[v].stage != AUDIO_SYNTH_RELEASE) break;
+        }
+        if (v < AUDIO_DAC_SYNTH_VOICES) {
+            claimed[v]    = true;
+            increments[i] = increments[--pending];
+        } else {
+            i++;
+        }
+    }
+
+    // Retune the remaining sounding voices, so pitch bends stay phase continuous, and release the rest
+    for (uint8_t v = 0; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+        if (claimed[v] || voices[v].stage == AUDIO_SYNTH_OFF || voices[v].stage == AUDIO_SYNTH_RELEASE) continue;
+        if (pending) {
+            voices[v].increment = increments[--pending];
+            claimed[v]          = true;
+        } else {
+            voices[v].stage = AUDIO_SYNTH_RELEASE;
+        }
+    }
+
+    // Start new frequencies on free voices, stealing the quietest released voice if there is none
+    while (pending) {
+        audio_synth_voice_t *voice = NULL;
+        for (uint8_t v = 0; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+            if (claimed[v]) continue;
+            if (voices[v].stage == AUDIO_SYNTH_OFF) {
+                voice = &voices[v];
+                break;
+            }
+            if (!voice || voices[v].level < voice->level) {
+                voice = &voices[v];
+            }
+        }
+        if (!voice) break;
+        claimed[voice - voices] = true;
+        voice_start(voice, increments[--pending]);
+    }
+}
+
+void audio_synth_release_all(void) {
+    for (uint8_t v = 0; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+        if (voices[v].stage != AUDIO_SYNTH_OFF) {
+            voices[v].stage = AUDIO_SYNTH_RELEASE;
+        }
+    }
+}
+
+bool audio_synth_is_active(void) {
+    for (uint8_t v = 0; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+        if (voices[v].stage != AUDIO_SYNTH_OFF) return true;
+    }
+    return false;
+}
+
+void audio_synth_set_waveform(uint8_t voice, audio_synth_waveform_t waveform) {
+    if (voice < AUDIO_DAC_SYNTH_VOICES) voices[voice].waveform = waveform;
+}
+
+void audio_synth_set_gain(uint8_t voice, uint8_t gain) {
+    if (voice < AUDIO_DAC_SYNTH_VOICES) voices[voice].gain = gain;
+}
+
+static inline int32_t waveform_sample(uint8_t waveform, uint32_t phase) {
+    int32_t triangle;
+    switch (waveform) {
+        case AUDIO_SYNTH_SQUARE:
+            return phase < 0x80000000UL ? 32767 : -32767;
+        case AUDIO_SYNTH_SAWTOOTH:
+            // starts at the midpoint, like the other waveforms
+            return (int32_t)((phase + 0x80000000UL) >> 16) - 32768;
+        case AUDIO_SYNTH_TRIANGLE:
+        case AUDIO_SYNTH_TRAPEZOID:
+            // rises over the first half of the period, falls over the second; starts at the midpoint
+            triangle = (int32_t)((phase + 0x40000000UL) >> 15);
+            triangle = triangle < 65536 ? triangle - 32768 : 98304 - triangle;
+            if (waveform == AUDIO_SYNTH_TRAPEZOID) {
+                // a triangle clipped at a third of its amplitude
+                triangle *= 3;
+                triangle = triangle > 32767 ? 32767 : (triangle < -32767 ? -32767 : triangle);
+            }
+            return triangle;
+        default: {
+            // linear interpolation between the two nearest table entries
+            uint8_t index = phase >> 24;
+            int32_t a     = synth_sine[index];
+            int32_t b     = synth_sine[index + 1];
+            return a + (((b - a) * (int32_t)((phase >> 16) & 0xFF)) >> 8);
+        }
+    }
+}
+
+static inline void envelope_advance(audio_synth_voice_t *voice) {
+    switch (voice->stage) {
+        case AUDIO_SYNTH_ATTACK:
+            voice->level += attack_step;
+            if (voice->level >= ENVELOPE_FULL) {
+                voice->level = ENVELOPE_FULL;
+                voice->stage = AUDIO_SYNTH_DECAY;
+            }
+            break;
+        case AUDIO_SYNTH_DECAY:
+            if (voice->level > ENVELOPE_SUSTAIN + decay_step) {
+                voice->level -= decay_step;
+            } else {
+                voice->level = ENVELOPE_SUSTAIN;
+                voice->stage = AUDIO_SYNTH_SUSTAIN;
+            }
+            break;
+        case AUDIO_SYNTH_RELEASE:
+            if (voice->level > release_step) {
+                voice->level -= release_step;
+            } else {
+                voice->level     = 0;
+                voice->increment = 0;
+                voice->stage     = AUDIO_SYNTH_OFF;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+int16_t audio_synth_render(void) {
+    int32_t mix      = 0;
+    uint8_t sounding = 0;
+
+    for (uint8_t v = 0; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+        audio_synth_voice_t *voice = &voices[v];
+        if (voice->stage == AUDIO_SYNTH_OFF) continue;
+
+        sounding++;
+        int32_t sample = waveform_sample(voice->waveform, voice->phase);
+        // envelope in Q15, then the mixer level of the voice
+        sample = (sample * (int32_t)(voice->level >> 9)) >> 15;
+        mix += (sample * voice->gain) >> 8;
+
+        voice->phase += voice->increment;
+        envelope_advance(voice);
+    }
+
+    // Scale the sum by the number of voices. The gain drops right away when a voice starts, so the
+    // mix can't clip, but rises slowly when voices end, so the remaining ones don't jump in volume.
+    if (sounding) {
+        uint32_t target = (1UL << 16) / sounding;
+        if (target < mix_gain) {
+            mix_gain = target;
+        } else {
+            mix_gain += (target - mix_gain) / 64;
+        }
+    }
+    mix = (mix * (int32_t)(mix_gain >> 4)) >> 12;
+
+    return mix > 32767 ? 32767 : (mix < -32767 ? -32767 : mix);
+}
+
+uint16_t audio_synth_render_dac(void) {
+    return (AUDIO_DAC_SAMPLE_MAX / 2) + (((int32_t)audio_synth_render() * (int32_t)(AUDIO_DAC_SAMPLE_MAX / 2)) >> 15);
+}
@@ -0,0 +1,106 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "audio_dac.h"
+
+/*
+  Fixed-point wavetable synthesizer used by the additive DAC driver.
+
+  Every voice runs a 32 bit phase accumulator, where one full period of the
+  waveform equals 2^32, and a linear ADSR envelope. The per-sample work is
+  integer only; floats are only touched when the set of tones changes.
+
+  Nothing in here depends on ChibiOS, so the synthesizer can be rendered on
+  the host - see platforms/test/audio_dac_synth_tests.cpp.
+*/
+
+#ifndef AUDIO_DAC_SYNTH_VOICES
+#    define AUDIO_DAC_SYNTH_VOICES AUDIO_MAX_SIMULTANEOUS_TONES
+#endif
+
+/**
+ * Envelope timings, in milliseconds, and the sustain level (0-255) a voice
+ * decays to after the attack. A short attack and release avoids the clicks
+ * caused by starting or stopping a waveform away from its midpoint.
+ */
+#ifndef AUDIO_DAC_ENVELOPE_ATTACK_MS
+#    define AUDIO_DAC_ENVELOPE_ATTACK_MS 2
+#endif
+#ifndef AUDIO_DAC_ENVELOPE_DECAY_MS
+#    define AUDIO_DAC_ENVELOPE_DECAY_MS 0
+#endif
+#ifndef AUDIO_DAC_ENVELOPE_SUSTAIN
+#    define AUDIO_DAC_ENVELOPE_SUSTAIN 255
+#endif
+#ifndef AUDIO_DAC_ENVELOPE_RELEASE_MS
+#    define AUDIO_DAC_ENVELOPE_RELEASE_MS 10
+#endif
+
+typedef enum {
+    AUDIO_SYNTH_SINE,
+    AUDIO_SYNTH_TRIANGLE,
+    AUDIO_SYNTH_TRAPEZOID,
+    AUDIO_SYNTH_SQUARE,
+    AUDIO_SYNTH_SAWTOOTH,
+} audio_synth_waveform_t;
+
+typedef enum {
+    AUDIO_SYNTH_OFF,
+    AUDIO_SYNTH_ATTACK,
+    AUDIO_SYNTH_DECAY,
+    AUDIO_SYNTH_SUSTAIN,
+    AUDIO_SYNTH_RELEASE,
+} audio_synth_stage_t;
+
+typedef struct {
+    uint32_t phase;     // position in the waveform, a full period is 2^32
+    uint32_t increment; // phase advance per sample, 0 for a free voice
+    uint32_t level;     // envelope level, 1 << 24 is full volume
+    uint8_t  stage;     // audio_synth_stage_t
+    uint8_t  waveform;  // audio_synth_waveform_t
+    uint8_t  gain;      // mixer level of this voice, 0-255
+} audio_synth_voice_t;
+
+/**
+ * @brief Reset all voices, and derive the envelope rates for the given sample rate.
+ */
+void audio_synth_init(uint32_t sample_rate);
+
+/**
+ * @brief Play exactly the given frequencies, in Hz.
+ *
+ * Voices already playing one of the frequencies keep running, voices whose
+ * frequency changed (e.g. vibrato or glissando) are retuned without resetting
+ * their phase or envelope, surplus voices are released and new frequencies are
+ * started on free voices. Frequencies of 0 (rests) are ignored.
+ */
+void audio_synth_set_frequencies(const float *frequencies, uint8_t count);
+
+/**
+ * @brief Release all voices, which then fade out over the release time.
+ */
+void audio_synth_release_all(void);
+
+/**
+ * @brief Check whether any voice is still audible, including voices being released.
+ */
+bool audio_synth_is_active(void);
+
+void audio_synth_set_waveform(uint8_t voice, audio_synth_waveform_t waveform);
+void audio_synth_set_gain(uint8_t voice, uint8_t gain);
+
+/**
+ * @brief Render the next sample of all voices mixed together.
+ *
+ * @return signed sample, between -32767 and 32767
+ */
+int16_t audio_synth_render(void);
+
+/**
+ * @brief Render the next sample scaled to the DAC range, centered on AUDIO_DAC_SAMPLE_MAX / 2.
+ */
+uint16_t audio_synth_render_dac(void);
@@ -107,24 +107,44 @@ static const I2CConfig i2cconfig = {
 #endif
 };
 
+/**
+ * @brief Acquires exclusive access to the I2C peripheral, so that transactions
+ * issued from other threads (e.g. an asynchronous LED flush) are not
+ * interleaved, and starts the peripheral.
+ *
+ * @param address I2C address of the target device, already shifted
+ */
+static void i2c_prologue(uint8_t address) {
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    i2cAcquireBus(&I2C_DRIVER);
+#endif
+    i2c_address = address;
+    i2cStart(&I2C_DRIVER, &i2cconfig);
+}
+
 /**
  * @brief Handles any I2C error condition by stopping the I2C peripheral and
- * aborting any ongoing transactions. Furthermore ChibiOS status codes are
- * converted into QMK codes.
+ * aborting any ongoing transactions, then releases the peripheral. Furthermore
+ * ChibiOS status codes are converted into QMK codes.
  *
  * @param status ChibiOS specific I2C status code
  * @return i2c_status_t QMK specific I2C status code
  */
 static i2c_status_t i2c_epilogue(const msg_t status) {
-    if (status == MSG_OK) {
-        return I2C_STATUS_SUCCESS;
+    if (status != MSG_OK) {
+        // From ChibiOS HAL: "After a timeout the driver must be stopped and
+        // restarted because the bus is in an uncertain state." We also issue that
+        // hard stop in case of any error.
+        i2cStop(&I2C_DRIVER);
     }
 
-    // From ChibiOS HAL: "After a timeout the driver must be stopped and
-    // restarted because the bus is in an uncertain state." We also issue that
-    // hard stop in case of any error.
-    i2c_stop();
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    i2cReleaseBus(&I2C_DRIVER);
+#endif
 
+    if (status == MSG_OK) {
+        return I2C_STATUS_SUCCESS;
+    }
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
@@ -149,28 +169,24 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
-    i2c_address = address;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
-    return I2C_STATUS_SUCCESS;
+    i2c_prologue(address);
+    return i2c_epilogue(MSG_OK);
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2c_address = address;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue(address);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2c_address = address;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue(address);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2c_address = devaddr;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue(devaddr);
 
     uint8_t complete_packet[length + 1];
     for (uint16_t i = 0; i < length; i++) {
@@ -183,8 +199,7 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
 }
 
 i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2c_address = devaddr;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue(devaddr);
 
     uint8_t complete_packet[length + 2];
     for (uint16_t i = 0; i < length; i++) {
@@ -198,20 +213,24 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2c_address = devaddr;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue(devaddr);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2c_address = devaddr;
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue(devaddr);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 void i2c_stop(void) {
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    i2cAcquireBus(&I2C_DRIVER);
+#endif
     i2cStop(&I2C_DRIVER);
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    i2cReleaseBus(&I2C_DRIVER);
+#endif
 }
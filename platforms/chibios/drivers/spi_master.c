@@ -19,6 +19,9 @@
 #include "timer.h"
 
 static pin_t currentSlavePin = NO_PIN;
+#if SPI_USE_MUTUAL_EXCLUSION == TRUE
+static thread_t *currentOwner = NULL;
+#endif
 
 #if defined(K20x) || defined(KL2x) || defined(RP2040)
 static SPIConfig spiConfig = {NULL, 0, 0, 0};
@@ -51,10 +54,27 @@ __attribute__((weak)) void spi_init(void) {
     }
 }
 
+static inline void spi_release(void) {
+#if SPI_USE_MUTUAL_EXCLUSION == TRUE
+    currentOwner = NULL;
+    spiReleaseBus(&SPI_DRIVER);
+#endif
+}
+
 bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+#if SPI_USE_MUTUAL_EXCLUSION == TRUE
+    // Only fail if this thread already started a transaction, otherwise wait
+    // for the thread currently using the bus (e.g. an asynchronous LED flush)
+    if (slavePin == NO_PIN || currentOwner == chThdGetSelfX()) {
+        return false;
+    }
+    spiAcquireBus(&SPI_DRIVER);
+    currentOwner = chThdGetSelfX();
+#else
     if (currentSlavePin != NO_PIN || slavePin == NO_PIN) {
         return false;
     }
+#endif
 
 #if !(defined(WB32F3G71xx) || defined(WB32FQ95xx))
     uint16_t roundedDivisor = 2;
@@ -63,6 +83,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     }
 
     if (roundedDivisor < 2 || roundedDivisor > 256) {
+        spi_release();
         return false;
     }
 #endif
@@ -146,6 +167,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     }
 
     if (divisor < 1) {
+        spi_release();
         return false;
     }
 
@@ -260,6 +282,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 
 spi_status_t spi_write(uint8_t data) {
     uint8_t rxData;
+    spi_transmit_wait();
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
     return rxData;
@@ -267,25 +290,43 @@ spi_status_t spi_write(uint8_t data) {
 
 spi_status_t spi_read(void) {
     uint8_t data = 0;
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, 1, &data);
 
     return data;
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_transmit_wait(void) {
+    // The driver goes back to ready from the transfer complete interrupt
+    while (SPI_DRIVER.state == SPI_ACTIVE) {
+        chThdYield();
+    }
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
     if (currentSlavePin != NO_PIN) {
+        spi_transmit_wait();
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
+        spi_release();
     }
 }
@@ -79,10 +79,16 @@ void ws2812_setleds(LED_TYPE *ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_BITBANG_INTERRUPTIBLE
+    // only each LED is time dependent, interrupts may run in the gaps between them
+    for (uint8_t i = 0; i < leds; i++) {
+        chSysLock();
+#else
     // this code is very time dependent, so we need to disable interrupts
     chSysLock();
 
     for (uint8_t i = 0; i < leds; i++) {
+#endif
         // WS2812 protocol dictates grb order
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
         sendByte(ledarray[i].g);
@@ -100,10 +106,23 @@ void ws2812_setleds(LED_TYPE *ledarray, uint16_t leds) {
 
 #ifdef RGBW
         sendByte(ledarray[i].w);
+#endif
+#ifdef WS2812_BITBANG_INTERRUPTIBLE
+        chSysUnlock();
 #endif
     }
 
+#ifdef WS2812_BITBANG_INTERRUPTIBLE
+    chSysLock();
+#endif
     wait_ns(WS2812_RES);
 
     chSysUnlock();
 }
+
+void ws2812_setleds_async(LED_TYPE *ledarray, uint16_t leds, ws2812_complete_cb_t complete) {
+    ws2812_setleds(ledarray, leds);
+    if (complete) {
+        complete();
+    }
+}
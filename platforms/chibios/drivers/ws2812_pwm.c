@@ -394,3 +394,12 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
 #endif
     }
 }
+
+// The DMA transfer is circular, so the frame buffer is streamed continuously
+// and a frame is on the wire as soon as it has been written to the buffer.
+void ws2812_setleds_async(LED_TYPE* ledarray, uint16_t leds, ws2812_complete_cb_t complete) {
+    ws2812_setleds(ledarray, leds);
+    if (complete) {
+        complete();
+    }
+}
@@ -84,28 +84,36 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// Without a circular or synchronous transfer, one frame can be on the wire
+// while the next one is converted into the second buffer and queued behind it.
+#if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+#    define TX_BUFFER_COUNT 1
+#else
+#    define WS2812_SPI_DOUBLE_BUFFER
+#    define TX_BUFFER_COUNT 2
+#endif
+
+static uint8_t txbuf[TX_BUFFER_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {{0}};
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static volatile int8_t      tx_active = -1; // buffer on the wire, -1 when idle
+static volatile int8_t      tx_queued = -1; // buffer waiting for the wire, -1 when none
+static ws2812_complete_cb_t tx_complete[TX_BUFFER_COUNT];
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
  * the ws2812b protocol, we use this helper function to translate bytes into
  * 0s and 1s for the LED (with the appropriate timing).
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+static inline uint8_t get_protocol_eq(uint8_t data, int pos) {
+    // SPI patterns for each pair of bits, precomputed: 0 -> 0b1000, 1 -> 0b1110
+    static const uint8_t patterns[4] = {0b10001000, 0b10001110, 0b11101000, 0b11101110};
+    return patterns[(data >> (2 * (3 - pos))) & 0b11];
 }
 
-static void set_led_color_rgb(LED_TYPE color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_led_color_rgb(uint8_t* tx, LED_TYPE color, int pos) {
+    uint8_t* tx_start = &tx[PREAMBLE_SIZE];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
     for (int j = 0; j < 4; j++)
@@ -135,6 +143,28 @@ static void set_led_color_rgb(LED_TYPE color, int pos) {
 #endif
 }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static void ws2812_spi_end_cb(SPIDriver* spip) {
+    chSysLockFromISR();
+    ws2812_complete_cb_t complete = tx_complete[tx_active];
+    if (tx_queued >= 0) {
+        tx_active = tx_queued;
+        tx_queued = -1;
+        spiStartSendI(spip, sizeof(txbuf[0]), txbuf[tx_active]);
+    } else {
+        tx_active = -1;
+    }
+    chSysUnlockFromISR();
+
+    if (complete) {
+        complete();
+    }
+}
+#    define WS2812_SPI_END_CB ws2812_spi_end_cb
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
+
 void ws2812_init(void) {
     palSetLineMode(RGB_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -149,7 +179,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(RGB_DI_PIN),
         PAL_PAD(RGB_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -168,7 +198,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_END_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(RGB_DI_PIN),
         PAL_PAD(RGB_DI_PIN),
@@ -181,10 +211,49 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI, sizeof(txbuf[0]), txbuf[0]);
 #endif
 }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+void ws2812_setleds_async(LED_TYPE* ledarray, uint16_t leds, ws2812_complete_cb_t complete) {
+    static bool s_init = false;
+    if (!s_init) {
+        ws2812_init();
+        s_init = true;
+    }
+
+    // Take back any frame still queued, it is replaced by this one
+    chSysLock();
+    int8_t replaced = tx_queued;
+    tx_queued       = -1;
+    uint8_t buf     = tx_active == 0 ? 1 : 0;
+    chSysUnlock();
+
+    // The replaced frame is never sent, complete it anyway so its caller isn't left waiting
+    if (replaced >= 0 && tx_complete[replaced]) {
+        tx_complete[replaced]();
+    }
+
+    for (uint8_t i = 0; i < leds; i++) {
+        set_led_color_rgb(txbuf[buf], ledarray[i], i);
+    }
+    tx_complete[buf] = complete;
+
+    chSysLock();
+    if (tx_active < 0) {
+        tx_active = buf;
+        spiStartSendI(&WS2812_SPI, sizeof(txbuf[buf]), txbuf[buf]);
+    } else {
+        tx_queued = buf;
+    }
+    chSysUnlock();
+}
+
+void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
+    ws2812_setleds_async(ledarray, leds, NULL);
+}
+#else
 void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
     static bool s_init = false;
     if (!s_init) {
@@ -193,16 +262,18 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
     }
 
     for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
+        set_led_color_rgb(txbuf[0], ledarray[i], i);
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
-#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
-#    else
-    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI, sizeof(txbuf[0]), txbuf[0]);
 #    endif
-#endif
 }
+
+void ws2812_setleds_async(LED_TYPE* ledarray, uint16_t leds, ws2812_complete_cb_t complete) {
+    ws2812_setleds(ledarray, leds);
+    if (complete) {
+        complete();
+    }
+}
+#endif
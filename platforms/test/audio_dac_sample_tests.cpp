@@ -0,0 +1,294 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "audio_dac_sample.h"
+}
+
+#ifndef AUDIO_SAMPLE_WAV_DIR
+#    define AUDIO_SAMPLE_WAV_DIR "."
+#endif
+
+#define OUTPUT_RATE 48000
+
+static int output_starts = 0;
+
+extern "C" void audio_sample_start_output(void) {
+    output_starts++;
+}
+
+/* Write mono 16-bit PCM, so the decoded audio can be listened to or inspected
+ * with any audio editor. The files end up in the test build directory. */
+static void write_wav(const std::string &name, const std::vector<int16_t> &samples) {
+    std::string path = std::string(AUDIO_SAMPLE_WAV_DIR) + "/" + name + ".wav";
+    FILE       *f    = fopen(path.c_str(), "wb");
+    if (!f) return;
+
+    auto put32 = [f](uint32_t v) { fwrite(&v, 4, 1, f); };
+    auto put16 = [f](uint16_t v) { fwrite(&v, 2, 1, f); };
+
+    uint32_t data_size = samples.size() * sizeof(int16_t);
+    fwrite("RIFF", 1, 4, f);
+    put32(36 + data_size);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(16);
+    put16(1); // PCM
+    put16(1); // mono
+    put32(OUTPUT_RATE);
+    put32(OUTPUT_RATE * sizeof(int16_t));
+    put16(sizeof(int16_t));
+    put16(16);
+    fwrite("data", 1, 4, f);
+    put32(data_size);
+    fwrite(samples.data(), sizeof(int16_t), samples.size(), f);
+    fclose(f);
+}
+
+static std::vector<int16_t> sine(float frequency, uint32_t rate, uint32_t count, float amplitude = 20000.0f) {
+    std::vector<int16_t> samples;
+    for (uint32_t n = 0; n < count; n++) {
+        samples.push_back((int16_t)lrintf(amplitude * sinf(2.0f * (float)M_PI * frequency * n / rate)));
+    }
+    return samples;
+}
+
+static void put_le(std::vector<uint8_t> &out, uint32_t value, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        out.push_back(value >> (8 * i));
+    }
+}
+
+/* The same encoding as lib/python/qmk/audio_sample.py, 'qmk audio-convert-sample'. */
+static std::vector<uint8_t> encode(audio_sample_format_t format, uint32_t rate, const std::vector<int16_t> &samples) {
+    static const int16_t steps[89]  = {7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+    static const int8_t  indexes[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+    std::vector<uint8_t> data;
+    int32_t              predictor = format == AUDIO_SAMPLE_IMA_ADPCM ? samples[0] : 0;
+    int32_t              index     = 0;
+
+    data.insert(data.end(), {'Q', 'A', 'S', AUDIO_SAMPLE_VERSION, (uint8_t)format, 0});
+    put_le(data, (uint16_t)predictor, 2);
+    put_le(data, rate, 4);
+    put_le(data, samples.size(), 4);
+
+    for (size_t n = 0; n < samples.size(); n++) {
+        switch (format) {
+            case AUDIO_SAMPLE_PCM8:
+                data.push_back(samples[n] >> 8);
+                break;
+            case AUDIO_SAMPLE_PCM16:
+                put_le(data, (uint16_t)samples[n], 2);
+                break;
+            case AUDIO_SAMPLE_IMA_ADPCM: {
+                int32_t step  = steps[index];
+                int32_t diff  = samples[n] - predictor;
+                int32_t delta = step >> 3;
+                uint8_t code  = 0;
+                if (diff < 0) {
+                    code = 8;
+                    diff = -diff;
+                }
+                if (diff >= step) {
+                    code |= 4;
+                    diff -= step;
+                    delta += step;
+                }
+                if (diff >= step >> 1) {
+                    code |= 2;
+                    diff -= step >> 1;
+                    delta += step >> 1;
+                }
+                if (diff >= step >> 2) {
+                    code |= 1;
+                    delta += step >> 2;
+                }
+                predictor = std::max(-32768, std::min(32767, predictor + ((code & 8) ? -delta : delta)));
+                index     = std::max(0, std::min(88, index + indexes[code & 7]));
+                if (n % 2) {
+                    data.back() |= code << 4;
+                } else {
+                    data.push_back(code);
+                }
+                break;
+            }
+        }
+    }
+    return data;
+}
+
+static std::vector<int16_t> render_all(uint32_t limit = OUTPUT_RATE * 10) {
+    std::vector<int16_t> out;
+    while (audio_sample_is_playing() && out.size() < limit) {
+        out.push_back(audio_sample_render());
+        audio_sample_task();
+    }
+    return out;
+}
+
+static uint32_t rising_zero_crossings(const std::vector<int16_t> &samples) {
+    uint32_t crossings = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        if (samples[i - 1] < 0 && samples[i] >= 0) crossings++;
+    }
+    return crossings;
+}
+
+// stands in for an external flash chip, recording how it is read
+static std::vector<uint8_t> flash;
+static uint32_t             flash_reads;
+static uint16_t             flash_largest_read;
+static bool                 flash_fails;
+
+static bool flash_read(uint32_t address, void *buffer, uint16_t length) {
+    if (flash_fails || address + length > flash.size()) return false;
+    memcpy(buffer, &flash[address], length);
+    flash_reads++;
+    flash_largest_read = std::max(flash_largest_read, length);
+    return true;
+}
+
+class AudioDacSample : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        audio_sample_init(OUTPUT_RATE);
+        audio_sample_stop();
+        audio_sample_set_gain(255);
+        output_starts      = 0;
+        flash_reads        = 0;
+        flash_largest_read = 0;
+        flash_fails        = false;
+    }
+};
+
+TEST_F(AudioDacSample, SilentWithoutSample) {
+    EXPECT_FALSE(audio_sample_is_playing());
+    EXPECT_EQ(audio_sample_render(), 0);
+}
+
+TEST_F(AudioDacSample, RejectsInvalidHeader) {
+    std::vector<uint8_t> data = encode(AUDIO_SAMPLE_PCM16, OUTPUT_RATE, sine(440, OUTPUT_RATE, 100));
+
+    data[0] = 'X';
+    EXPECT_FALSE(audio_sample_play(data.data()));
+    data[0] = 'Q';
+    data[4] = 0x7F; // unknown format
+    EXPECT_FALSE(audio_sample_play(data.data()));
+    EXPECT_FALSE(audio_sample_is_playing());
+    EXPECT_EQ(output_starts, 0);
+}
+
+TEST_F(AudioDacSample, Pcm16IsBitExact) {
+    std::vector<int16_t> samples = sine(1000, OUTPUT_RATE, OUTPUT_RATE / 10, 32767);
+    std::vector<uint8_t> data    = encode(AUDIO_SAMPLE_PCM16, OUTPUT_RATE, samples);
+
+    ASSERT_TRUE(audio_sample_play(data.data()));
+    EXPECT_EQ(output_starts, 1);
+    std::vector<int16_t> out = render_all();
+
+    // at the same rate, the interpolation delays the output by one sample, and ends on silence
+    ASSERT_EQ(out.size(), samples.size() + 2);
+    for (size_t n = 0; n < samples.size(); n++) {
+        ASSERT_EQ(out[n + 1], samples[n]);
+    }
+    EXPECT_EQ(out.back(), 0);
+}
+
+TEST_F(AudioDacSample, AdpcmDecodesCloseToTheOriginal) {
+    std::vector<int16_t> samples = sine(440, OUTPUT_RATE, OUTPUT_RATE / 2);
+    std::vector<uint8_t> data    = encode(AUDIO_SAMPLE_IMA_ADPCM, OUTPUT_RATE, samples);
+
+    // four bits per sample
+    EXPECT_EQ(data.size(), AUDIO_SAMPLE_HEADER_SIZE + samples.size() / 2);
+
+    ASSERT_TRUE(audio_sample_play(data.data()));
+    std::vector<int16_t> out = render_all();
+    write_wav("audio_dac_sample_adpcm_440", out);
+    ASSERT_EQ(out.size(), samples.size() + 2);
+
+    double error = 0, signal = 0;
+    for (size_t n = 0; n < samples.size(); n++) {
+        error += pow(out[n + 1] - samples[n], 2);
+        signal += pow(samples[n], 2);
+    }
+    // better than 30dB signal-to-noise, for a smooth waveform
+    EXPECT_GT(10 * log10(signal / error), 30);
+}
+
+TEST_F(AudioDacSample, ResamplesToTheOutputRate) {
+    std::vector<int16_t> samples = sine(400, 8000, 8000);
+    std::vector<uint8_t> data    = encode(AUDIO_SAMPLE_PCM8, 8000, samples);
+
+    ASSERT_TRUE(audio_sample_play(data.data()));
+    std::vector<int16_t> out = render_all();
+    write_wav("audio_dac_sample_pcm8_8khz", out);
+
+    // one second of audio, still at 400Hz
+    EXPECT_NEAR(out.size(), OUTPUT_RATE, 12);
+    EXPECT_NEAR(rising_zero_crossings(out), 400, 1);
+}
+
+TEST_F(AudioDacSample, StreamsInSmallReads) {
+    std::vector<int16_t> samples = sine(440, OUTPUT_RATE, OUTPUT_RATE / 4);
+    flash.assign(1000, 0xFF); // the sample doesn't have to start at the beginning of the flash
+    std::vector<uint8_t> data = encode(AUDIO_SAMPLE_IMA_ADPCM, OUTPUT_RATE, samples);
+    flash.insert(flash.end(), data.begin(), data.end());
+
+    ASSERT_TRUE(audio_sample_play_from(flash_read, 1000));
+    std::vector<int16_t> out = render_all();
+
+    EXPECT_EQ(out.size(), samples.size() + 2);
+    EXPECT_LE(flash_largest_read, AUDIO_SAMPLE_BUFFER_SIZE);
+    EXPECT_GT(flash_reads, data.size() / AUDIO_SAMPLE_BUFFER_SIZE);
+}
+
+TEST_F(AudioDacSample, HoldsOnUnderrun) {
+    std::vector<int16_t> samples = sine(100, OUTPUT_RATE, AUDIO_SAMPLE_BUFFER_SIZE * 8);
+    std::vector<uint8_t> data    = encode(AUDIO_SAMPLE_PCM8, OUTPUT_RATE, samples);
+
+    ASSERT_TRUE(audio_sample_play(data.data()));
+
+    // the main loop is stuck: the buffered data plays, then the last value is held
+    std::vector<int16_t> out;
+    for (int n = 0; n < AUDIO_SAMPLE_BUFFER_SIZE * 2; n++) {
+        out.push_back(audio_sample_render());
+    }
+    EXPECT_TRUE(audio_sample_is_playing());
+    EXPECT_EQ(out[AUDIO_SAMPLE_BUFFER_SIZE], (int16_t)(samples[AUDIO_SAMPLE_BUFFER_SIZE - 1] & 0xFF00));
+    EXPECT_EQ(out.back(), out[AUDIO_SAMPLE_BUFFER_SIZE]);
+
+    // and once it has caught up, playback carries on where it left off
+    audio_sample_task();
+    EXPECT_EQ(audio_sample_render(), (int16_t)(samples[AUDIO_SAMPLE_BUFFER_SIZE] & 0xFF00));
+}
+
+TEST_F(AudioDacSample, StopsOnReadError) {
+    std::vector<int16_t> samples = sine(440, OUTPUT_RATE, AUDIO_SAMPLE_BUFFER_SIZE * 8);
+    flash                        = encode(AUDIO_SAMPLE_PCM16, OUTPUT_RATE, samples);
+
+    ASSERT_TRUE(audio_sample_play_from(flash_read, 0));
+    for (int n = 0; n < AUDIO_SAMPLE_BUFFER_SIZE / 2; n++) {
+        audio_sample_render();
+    }
+    flash_fails = true;
+    audio_sample_task();
+    EXPECT_FALSE(audio_sample_is_playing());
+    EXPECT_EQ(audio_sample_render(), 0);
+}
+
+TEST_F(AudioDacSample, Gain) {
+    std::vector<int16_t> samples(100, 16384);
+    std::vector<uint8_t> data = encode(AUDIO_SAMPLE_PCM16, OUTPUT_RATE, samples);
+
+    audio_sample_set_gain(127);
+    ASSERT_TRUE(audio_sample_play(data.data()));
+    audio_sample_render();
+    EXPECT_EQ(audio_sample_render(), 8192);
+}
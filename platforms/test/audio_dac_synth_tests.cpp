@@ -0,0 +1,172 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "audio_dac_synth.h"
+}
+
+#ifndef AUDIO_SYNTH_WAV_DIR
+#    define AUDIO_SYNTH_WAV_DIR "."
+#endif
+
+#define SAMPLE_RATE 48000
+
+/* Write mono 16-bit PCM, so the rendered audio can be listened to or inspected
+ * with any audio editor. The files end up in the test build directory. */
+static void write_wav(const std::string &name, const std::vector<int16_t> &samples) {
+    std::string path = std::string(AUDIO_SYNTH_WAV_DIR) + "/" + name + ".wav";
+    FILE       *f    = fopen(path.c_str(), "wb");
+    if (!f) return;
+
+    auto put32 = [f](uint32_t v) { fwrite(&v, 4, 1, f); };
+    auto put16 = [f](uint16_t v) { fwrite(&v, 2, 1, f); };
+
+    uint32_t data_size = samples.size() * sizeof(int16_t);
+    fwrite("RIFF", 1, 4, f);
+    put32(36 + data_size);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(16);
+    put16(1); // PCM
+    put16(1); // mono
+    put32(SAMPLE_RATE);
+    put32(SAMPLE_RATE * sizeof(int16_t));
+    put16(sizeof(int16_t));
+    put16(16);
+    fwrite("data", 1, 4, f);
+    put32(data_size);
+    fwrite(samples.data(), sizeof(int16_t), samples.size(), f);
+    fclose(f);
+}
+
+static void render(std::vector<int16_t> &out, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        out.push_back(audio_synth_render());
+    }
+}
+
+static uint32_t rising_zero_crossings(const std::vector<int16_t> &samples) {
+    uint32_t crossings = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        if (samples[i - 1] < 0 && samples[i] >= 0) crossings++;
+    }
+    return crossings;
+}
+
+class AudioDacSynth : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        audio_synth_init(SAMPLE_RATE);
+    }
+};
+
+TEST_F(AudioDacSynth, SilentWithoutTones) {
+    EXPECT_FALSE(audio_synth_is_active());
+    EXPECT_EQ(audio_synth_render(), 0);
+    EXPECT_EQ(audio_synth_render_dac(), AUDIO_DAC_SAMPLE_MAX / 2);
+}
+
+TEST_F(AudioDacSynth, SineHasRequestedFrequency) {
+    std::vector<int16_t> samples;
+    float                frequency = 440.0f;
+
+    audio_synth_set_frequencies(&frequency, 1);
+    render(samples, SAMPLE_RATE);
+    write_wav("audio_dac_synth_sine_440", samples);
+
+    EXPECT_NEAR(rising_zero_crossings(samples), 440, 1);
+}
+
+TEST_F(AudioDacSynth, EnvelopeAttackAndRelease) {
+    std::vector<int16_t> samples;
+    float                frequency = 1000.0f;
+
+    audio_synth_set_frequencies(&frequency, 1);
+    // the first sample of the attack is silent, so starting a tone doesn't click
+    EXPECT_EQ(audio_synth_render(), 0);
+
+    render(samples, SAMPLE_RATE * (AUDIO_DAC_ENVELOPE_ATTACK_MS + 10) / 1000);
+    int16_t peak = 0;
+    for (size_t i = samples.size() - SAMPLE_RATE / 1000; i < samples.size(); i++) {
+        peak = std::max<int16_t>(peak, samples[i]);
+    }
+    EXPECT_GT(peak, 32000);
+
+    audio_synth_release_all();
+    EXPECT_TRUE(audio_synth_is_active());
+    render(samples, SAMPLE_RATE * AUDIO_DAC_ENVELOPE_RELEASE_MS / 1000 + 1);
+    EXPECT_FALSE(audio_synth_is_active());
+    write_wav("audio_dac_synth_envelope", samples);
+}
+
+TEST_F(AudioDacSynth, RetuningIsPhaseContinuous) {
+    std::vector<int16_t> samples;
+    float                frequency = 440.0f;
+
+    audio_synth_set_frequencies(&frequency, 1);
+    render(samples, SAMPLE_RATE / 10);
+
+    // a vibrato sweeps the frequency in small steps, which must neither restart nor click
+    for (int i = 0; i < 100; i++) {
+        frequency = 440.0f + (i % 20) * 2.0f;
+        audio_synth_set_frequencies(&frequency, 1);
+        render(samples, SAMPLE_RATE / 1000);
+    }
+    write_wav("audio_dac_synth_vibrato", samples);
+
+    int32_t max_step = 0;
+    for (size_t i = SAMPLE_RATE / 10; i < samples.size(); i++) {
+        max_step = std::max<int32_t>(max_step, abs(samples[i] - samples[i - 1]));
+    }
+    // a full scale 480Hz sine moves at most 2*pi*480/48000 of its amplitude per sample
+    EXPECT_LT(max_step, 2100);
+}
+
+TEST_F(AudioDacSynth, ChordDoesNotClip) {
+    std::vector<int16_t> samples;
+    float                chord[] = {261.63f, 329.63f, 392.0f, 523.25f};
+
+    audio_synth_set_frequencies(chord, AUDIO_DAC_SYNTH_VOICES < 4 ? AUDIO_DAC_SYNTH_VOICES : 4);
+    render(samples, SAMPLE_RATE / 2);
+    audio_synth_release_all();
+    render(samples, SAMPLE_RATE / 50);
+    write_wav("audio_dac_synth_chord", samples);
+
+    uint32_t clipped = 0;
+    for (int16_t sample : samples) {
+        if (abs(sample) >= 32767) clipped++;
+    }
+    EXPECT_EQ(clipped, 0);
+    EXPECT_FALSE(audio_synth_is_active());
+}
+
+TEST_F(AudioDacSynth, RestsAreIgnored) {
+    float frequencies[] = {0.0f, 0.0f};
+
+    audio_synth_set_frequencies(frequencies, 2);
+    EXPECT_FALSE(audio_synth_is_active());
+}
+
+TEST_F(AudioDacSynth, Waveforms) {
+    std::vector<int16_t> samples;
+    float                frequency = 220.0f;
+
+    for (uint8_t v = 0; v < AUDIO_DAC_SYNTH_VOICES; v++) {
+        audio_synth_set_waveform(v, AUDIO_SYNTH_SQUARE);
+    }
+    audio_synth_set_frequencies(&frequency, 1);
+    render(samples, SAMPLE_RATE / 10);
+    write_wav("audio_dac_synth_square", samples);
+
+    // once the attack is over, a square wave only has two levels
+    for (size_t i = SAMPLE_RATE * AUDIO_DAC_ENVELOPE_ATTACK_MS / 1000 + 64; i < samples.size(); i++) {
+        ASSERT_GT(abs(samples[i]), 32000);
+    }
+    EXPECT_NEAR(rising_zero_crossings(samples), 22, 1);
+}
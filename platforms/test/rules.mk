@@ -23,3 +23,15 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+audio_dac_synth_DEFS := -DAUDIO_MAX_SIMULTANEOUS_TONES=4 -DAUDIO_SYNTH_WAV_DIR=\"$(BUILD_DIR)/test\"
+audio_dac_synth_INC := $(PLATFORM_PATH)/chibios/drivers
+audio_dac_synth_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/audio_dac_synth_tests.cpp \
+	$(PLATFORM_PATH)/chibios/drivers/audio_dac_synth.c
+
+audio_dac_sample_DEFS := -DAUDIO_SAMPLE_WAV_DIR=\"$(BUILD_DIR)/test\"
+audio_dac_sample_INC := $(PLATFORM_PATH)/chibios/drivers
+audio_dac_sample_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/audio_dac_sample_tests.cpp \
+	$(PLATFORM_PATH)/chibios/drivers/audio_dac_sample.c
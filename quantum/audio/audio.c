@@ -71,15 +71,56 @@ bool playing_melody = false; // playing a SONG?
 bool playing_note   = false; // or (possibly multiple simultaneous) tones
 bool state_changed  = false; // global flag, which is set if anything changes with the active_tones
 
-// melody/SONG related state variables
-float (*notes_pointer)[][2];                           // SONG, an array of MUSICAL_NOTEs
-uint16_t notes_count;                                  // length of the notes_pointer array
-bool     notes_repeat;                                 // PLAY_SONG or PLAY_LOOP?
-uint16_t melody_current_note_duration = 0;             // duration of the currently playing note from the active melody, in ms
-uint8_t  note_tempo                   = TEMPO_DEFAULT; // beats-per-minute
-uint16_t current_note                 = 0;             // index into the array at notes_pointer
-bool     note_resting                 = false;         // if a short pause was introduced between two notes with the same frequency while playing a melody
-uint16_t last_timestamp               = 0;
+// melody/SONG related state variables, one melody per priority level
+typedef struct {
+    float (*notes)[][2];    // SONG, an array of MUSICAL_NOTEs
+    uint16_t count;         // length of the notes array
+    uint16_t current;       // index into the notes array
+    uint16_t duration;      // duration of the currently playing note, in ms
+    uint16_t timestamp;     // time the currently playing note started
+    bool     repeat;        // PLAY_SONG or PLAY_LOOP?
+    bool     playing;       // is this melody active?
+    bool     resting;       // if a short pause was introduced between two notes with the same frequency
+} audio_melody_t;
+static audio_melody_t melodies[AUDIO_PRIORITY_COUNT];
+static float          click[2][2];
+uint8_t               note_tempo = TEMPO_DEFAULT; // beats-per-minute
+
+/* Commands from the public interface are queued, and carried out by
+ * 'audio_update_state' from within the driver's timer interrupt; so the
+ * interrupt is the only place the tone stack and melodies are changed while
+ * the driver is running. This is a single-producer/single-consumer ring
+ * buffer, where the main loop only ever writes 'command_head' and the
+ * interrupt only ever writes 'command_tail'.
+ */
+#ifndef AUDIO_COMMAND_QUEUE_SIZE
+#    define AUDIO_COMMAND_QUEUE_SIZE 8
+#endif
+_Static_assert((AUDIO_COMMAND_QUEUE_SIZE & (AUDIO_COMMAND_QUEUE_SIZE - 1)) == 0, "AUDIO_COMMAND_QUEUE_SIZE must be a power of two");
+
+typedef enum {
+    AUDIO_COMMAND_PLAY_NOTE,
+    AUDIO_COMMAND_STOP_TONE,
+    AUDIO_COMMAND_PLAY_MELODY,
+    AUDIO_COMMAND_PLAY_CLICK,
+    AUDIO_COMMAND_STOP_MELODY,
+    AUDIO_COMMAND_STOP_ALL,
+} audio_command_type_t;
+
+typedef struct {
+    uint8_t  type;     // audio_command_type_t
+    uint8_t  priority; // audio_priority_t
+    bool     repeat;   // melodies: loop
+    uint16_t duration; // notes and clicks: in ms; melodies: number of notes
+    uint16_t delay;    // clicks: pause before the click, in ms
+    float    pitch;
+    float (*notes)[][2];
+} audio_command_t;
+
+static audio_command_t  command_queue[AUDIO_COMMAND_QUEUE_SIZE];
+static volatile uint8_t command_head  = 0;
+static volatile uint8_t command_tail  = 0;
+static volatile bool    commands_busy = false;
 
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
 #    ifndef AUDIO_MAX_SIMULTANEOUS_TONES
@@ -109,7 +150,7 @@ float audio_on_song[][2]  = AUDIO_ON_SONG;
 float audio_off_song[][2] = AUDIO_OFF_SONG;
 
 static bool    audio_initialized    = false;
-static bool    audio_driver_stopped = true;
+static volatile bool audio_driver_stopped = true;
 audio_config_t audio_config;
 
 void audio_init() {
@@ -148,8 +189,6 @@ void audio_startup(void) {
     if (audio_config.enable) {
         PLAY_SONG(startup_song);
     }
-
-    last_timestamp = timer_read();
 }
 
 void audio_toggle(void) {
@@ -185,7 +224,7 @@ bool audio_is_on(void) {
     return (audio_config.enable != 0);
 }
 
-void audio_stop_all() {
+static void audio_do_stop_all(void) {
     if (audio_driver_stopped) {
         return;
     }
@@ -197,7 +236,9 @@ void audio_stop_all() {
     playing_melody = false;
     playing_note   = false;
 
-    melody_current_note_duration = 0;
+    for (uint8_t i = 0; i < AUDIO_PRIORITY_COUNT; i++) {
+        melodies[i].playing = false;
+    }
 
     for (uint8_t i = 0; i < AUDIO_TONE_STACKSIZE; i++) {
         tones[i] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
@@ -206,86 +247,94 @@ void audio_stop_all() {
     audio_driver_stopped = true;
 }
 
-void audio_stop_tone(float pitch) {
+// remove the tone at the given index from the stack
+static void audio_remove_tone(uint8_t index) {
+    for (uint8_t j = index; j < AUDIO_TONE_STACKSIZE - 1; j++) {
+        tones[j] = tones[j + 1];
+    }
+    tones[AUDIO_TONE_STACKSIZE - 1] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
+
+    state_changed = true;
+    active_tones--;
+#ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
+    if (tone_multiplexing_index_shift >= active_tones) {
+        tone_multiplexing_index_shift = 0;
+    }
+#endif
+    if (active_tones == 0) {
+        // without a running driver there is nothing advancing the melodies either
+        for (uint8_t i = 0; i < AUDIO_PRIORITY_COUNT; i++) {
+            melodies[i].playing = false;
+        }
+        audio_driver_stop();
+        audio_driver_stopped = true;
+        playing_note         = false;
+        playing_melody       = false;
+    }
+}
+
+static void audio_do_stop_tone(float pitch) {
     if (pitch < 0.0f) {
         pitch = -1 * pitch;
     }
 
     if (playing_note) {
-        if (!audio_initialized) {
-            audio_init();
-        }
-        bool found = false;
-        for (int i = AUDIO_TONE_STACKSIZE - 1; i >= 0; i--) {
-            found = (tones[i].pitch == pitch);
-            if (found) {
-                tones[i] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
-                for (int j = i; (j < AUDIO_TONE_STACKSIZE - 1); j++) {
-                    tones[j]     = tones[j + 1];
-                    tones[j + 1] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
-                }
-                break;
+        for (int i = active_tones - 1; i >= 0; i--) {
+            if (tones[i].pitch == pitch) {
+                audio_remove_tone(i);
+                return;
             }
         }
-        if (!found) {
-            return;
-        }
+    }
+}
 
-        state_changed = true;
-        active_tones--;
-        if (active_tones < 0) active_tones = 0;
-#ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
-        if (tone_multiplexing_index_shift >= active_tones) {
-            tone_multiplexing_index_shift = 0;
-        }
-#endif
-        if (active_tones == 0) {
-            audio_driver_stop();
-            audio_driver_stopped = true;
-            playing_note         = false;
+// remove the tones of the given priority, except for the one just started with 'keep_pitch'
+static void audio_stop_priority(uint8_t priority, float keep_pitch) {
+    for (int i = active_tones - 1; i >= 0; i--) {
+        if (tones[i].priority == priority && tones[i].pitch != keep_pitch) {
+            audio_remove_tone(i);
         }
     }
 }
 
-void audio_play_note(float pitch, uint16_t duration) {
+static void audio_do_play_note(float pitch, uint16_t duration, uint8_t priority) {
     if (!audio_config.enable) {
         return;
     }
 
-    if (!audio_initialized) {
-        audio_init();
-    }
-
     if (pitch < 0.0f) {
         pitch = -1 * pitch;
     }
 
-    // round-robin: shifting out old tones, keeping only unique ones
-    // if the new frequency is already amongst the active tones, shift it to the top of the stack
-    bool found = false;
+    // keeping only unique frequencies: if the new frequency is already amongst the active tones, it is replaced
     for (int i = active_tones - 1; i >= 0; i--) {
-        found = (tones[i].pitch == pitch);
-        if (found) {
-            for (int j = i; (j < active_tones - 1); j++) {
-                tones[j]     = tones[j + 1];
-                tones[j + 1] = (musical_tone_t){.time_started = timer_read(), .pitch = pitch, .duration = duration};
+        if (tones[i].pitch == pitch) {
+            for (int j = i; j < active_tones - 1; j++) {
+                tones[j] = tones[j + 1];
             }
-            return; // since this frequency played already, the hardware was already started
+            active_tones--;
+            break;
         }
     }
 
-    // frequency/tone is actually new, so we put it on the top of the stack
-    active_tones++;
-    if (active_tones > AUDIO_TONE_STACKSIZE) {
-        active_tones = AUDIO_TONE_STACKSIZE;
-        // shift out the oldest tone to make room
+    // round-robin: shift out the oldest tone of the lowest priority to make room
+    if (active_tones == AUDIO_TONE_STACKSIZE) {
         for (int i = 0; i < active_tones - 1; i++) {
             tones[i] = tones[i + 1];
         }
+        active_tones--;
     }
-    state_changed           = true;
-    playing_note            = true;
-    tones[active_tones - 1] = (musical_tone_t){.time_started = timer_read(), .pitch = pitch, .duration = duration};
+
+    // the stack is ordered by priority; the new tone goes on top of the tones with the same or a lower priority
+    int index = active_tones;
+    while (index > 0 && tones[index - 1].priority > priority) {
+        tones[index] = tones[index - 1];
+        index--;
+    }
+    active_tones++;
+    state_changed = true;
+    playing_note  = true;
+    tones[index]  = (musical_tone_t){.time_started = timer_read(), .pitch = pitch, .duration = duration, .priority = priority};
 
     // TODO: needs to be handled per note/tone -> use its timestamp instead?
     voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
@@ -296,41 +345,41 @@ void audio_play_note(float pitch, uint16_t duration) {
     }
 }
 
-void audio_play_tone(float pitch) {
-    audio_play_note(pitch, 0xffff);
+static void audio_update_playing_melody(void) {
+    playing_melody = false;
+    for (uint8_t i = 0; i < AUDIO_PRIORITY_COUNT; i++) {
+        playing_melody |= melodies[i].playing;
+    }
 }
 
-void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+static void audio_do_stop_melody(uint8_t priority) {
+    melodies[priority].playing = false;
+    audio_update_playing_melody();
+    audio_stop_priority(priority, -1.0f);
+}
+
+static void audio_do_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat, uint8_t priority) {
     if (!audio_config.enable) {
-        audio_stop_all();
+        audio_do_stop_all();
         return;
     }
 
-    if (!audio_initialized) {
-        audio_init();
-    }
-
-    // Cancel note if a note is playing
-    if (playing_note) audio_stop_all();
-
-    playing_melody = true;
-    note_resting   = false;
-
-    notes_pointer = np;
-    notes_count   = n_count;
-    notes_repeat  = n_repeat;
-
-    current_note = 0; // note in the melody-array/list at note_pointer
+    audio_melody_t *melody = &melodies[priority];
+    *melody                = (audio_melody_t){.notes = np, .count = n_count, .repeat = n_repeat, .playing = true};
+    playing_melody         = true;
 
     // start first note manually, which also starts the audio_driver
     // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
-    last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    melody->duration = audio_duration_to_ms((*np)[0][1]);
+    audio_do_play_note((*np)[0][0], melody->duration, priority);
+    melody->timestamp = timer_read();
+
+    // a new melody replaces the one playing with the same priority; others keep playing underneath or on top.
+    // the previous tones are removed only now, so the driver is not stopped and restarted in between
+    audio_stop_priority(priority, (*np)[0][0] < 0.0f ? -(*np)[0][0] : (*np)[0][0]);
 }
 
-float click[2][2];
-void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
+static void audio_do_play_click(uint16_t delay, float pitch, uint16_t duration) {
     uint16_t duration_tone  = audio_ms_to_duration(duration);
     uint16_t duration_delay = audio_ms_to_duration(delay);
 
@@ -339,7 +388,7 @@ void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
         click[0][1] = duration_tone;
         click[1][0] = 0.0f;
         click[1][1] = 0.0f;
-        audio_play_melody(&click, 1, false);
+        audio_do_play_melody(&click, 1, false, AUDIO_PRIORITY_CLICKY);
     } else {
         // first note is a rest/pause
         click[0][0] = 0.0f;
@@ -347,8 +396,120 @@ void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
         // second note is the actual click
         click[1][0] = pitch;
         click[1][1] = duration_tone;
-        audio_play_melody(&click, 2, false);
+        audio_do_play_melody(&click, 2, false, AUDIO_PRIORITY_CLICKY);
+    }
+}
+
+static void audio_run_command(const audio_command_t *command) {
+    switch (command->type) {
+        case AUDIO_COMMAND_PLAY_NOTE:
+            audio_do_play_note(command->pitch, command->duration, command->priority);
+            break;
+        case AUDIO_COMMAND_STOP_TONE:
+            audio_do_stop_tone(command->pitch);
+            break;
+        case AUDIO_COMMAND_PLAY_MELODY:
+            audio_do_play_melody(command->notes, command->duration, command->repeat, command->priority);
+            break;
+        case AUDIO_COMMAND_PLAY_CLICK:
+            audio_do_play_click(command->delay, command->pitch, command->duration);
+            break;
+        case AUDIO_COMMAND_STOP_MELODY:
+            audio_do_stop_melody(command->priority);
+            break;
+        case AUDIO_COMMAND_STOP_ALL:
+            audio_do_stop_all();
+            break;
+    }
+}
+
+/**
+ * @brief carry out all queued commands
+ * @return false if the queue is already being processed further down the stack
+ */
+static bool audio_run_commands(void) {
+    // an interrupt can not be interrupted by the main loop, so checking then setting the flag is safe
+    if (commands_busy) {
+        return false;
+    }
+    commands_busy = true;
+
+    uint8_t tail = command_tail;
+    while (tail != command_head) {
+        audio_run_command(&command_queue[tail]);
+        tail         = (tail + 1) & (AUDIO_COMMAND_QUEUE_SIZE - 1);
+        command_tail = tail;
+    }
+
+    commands_busy = false;
+    return true;
+}
+
+static void audio_queue_command(const audio_command_t *command) {
+    if (!audio_initialized) {
+        audio_init();
     }
+
+    uint8_t head = command_head;
+    uint8_t next = (head + 1) & (AUDIO_COMMAND_QUEUE_SIZE - 1);
+    while (next == command_tail) {
+        // queue is full; the driver has not been able to catch up for several of its ticks. Rather wait for
+        // its next one than drop the command: a lost stop would leave a tone started by 'play_note' playing
+        if (audio_driver_stopped) {
+            audio_run_commands();
+        }
+    }
+    command_queue[head] = *command;
+    // make sure the command is written before the interrupt can see it
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    command_head = next;
+
+    // a stopped driver does not call 'audio_update_state', so start things off from here
+    if (audio_driver_stopped) {
+        audio_run_commands();
+    }
+}
+
+void audio_stop_all() {
+    audio_queue_command(&(audio_command_t){.type = AUDIO_COMMAND_STOP_ALL});
+}
+
+void audio_stop_tone(float pitch) {
+    audio_queue_command(&(audio_command_t){.type = AUDIO_COMMAND_STOP_TONE, .pitch = pitch});
+}
+
+void audio_play_note_with_priority(float pitch, uint16_t duration, audio_priority_t priority) {
+    if (!audio_config.enable) {
+        return;
+    }
+    audio_queue_command(&(audio_command_t){.type = AUDIO_COMMAND_PLAY_NOTE, .pitch = pitch, .duration = duration, .priority = priority});
+}
+
+void audio_play_note(float pitch, uint16_t duration) {
+    audio_play_note_with_priority(pitch, duration, AUDIO_PRIORITY_MUSIC);
+}
+
+void audio_play_tone(float pitch) {
+    audio_play_note(pitch, 0xffff);
+}
+
+void audio_play_melody_with_priority(float (*np)[][2], uint16_t n_count, bool n_repeat, audio_priority_t priority) {
+    audio_queue_command(&(audio_command_t){.type = AUDIO_COMMAND_PLAY_MELODY, .notes = np, .duration = n_count, .repeat = n_repeat, .priority = priority});
+}
+
+void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+    audio_play_melody_with_priority(np, n_count, n_repeat, AUDIO_PRIORITY_MELODY);
+}
+
+void audio_stop_melody(audio_priority_t priority) {
+    audio_queue_command(&(audio_command_t){.type = AUDIO_COMMAND_STOP_MELODY, .priority = priority});
+}
+
+void audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
+    if (!audio_config.enable) {
+        return;
+    }
+    audio_queue_command(&(audio_command_t){.type = AUDIO_COMMAND_PLAY_CLICK, .delay = delay, .pitch = pitch, .duration = duration});
 }
 
 bool audio_is_playing_note(void) {
@@ -391,7 +552,81 @@ float audio_get_processed_frequency(uint8_t tone_index) {
     return voice_envelope(tones[index].pitch);
 }
 
+// advance a melody to its next note, once the current one has played for its duration
+static void audio_advance_melody(uint8_t priority, uint16_t current_time) {
+    audio_melody_t *melody = &melodies[priority];
+
+    if (timer_elapsed(melody->timestamp) < melody->duration) {
+        return;
+    }
+
+    uint16_t delta         = timer_elapsed(melody->timestamp) - melody->duration;
+    melody->timestamp      = current_time;
+    uint16_t previous_note = melody->current;
+    melody->current++;
+    voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
+
+    if (melody->current >= melody->count) {
+        if (melody->repeat) {
+            melody->current = 0;
+        } else {
+            audio_do_stop_melody(priority);
+            return;
+        }
+    }
+
+    if (!melody->resting && (*melody->notes)[previous_note][0] == (*melody->notes)[melody->current][0]) {
+        melody->resting = true;
+
+        // special handling for successive notes of the same frequency:
+        // insert a short pause to separate them audibly
+        audio_do_play_note(0.0f, audio_duration_to_ms(2), priority);
+        melody->current  = previous_note;
+        melody->duration = audio_duration_to_ms(2);
+
+    } else {
+        melody->resting = false;
+
+        // TODO: handle glissando here (or remember previous and current tone)
+        /* there would need to be a freq(here we are) -> freq(next note)
+         * and do slide/glissando in between problem here is to know which
+         * frequency on the stack relates to what other? e.g. a melody starts
+         * tones in a sequence, and stops expiring one, so the most recently
+         * stopped is the starting point for a glissando to the most recently started?
+         * how to detect and preserve this relation?
+         * and what about user input, chords, ...?
+         */
+
+        // '- delta': Skip forward in the next note's length if we've over shot
+        //            the last, so the overall length of the song is the same
+        uint16_t duration = audio_duration_to_ms((*melody->notes)[melody->current][1]);
+
+        // Skip forward past any completely missed notes
+        while (delta > duration && melody->current < melody->count - 1) {
+            delta -= duration;
+            melody->current++;
+            duration = audio_duration_to_ms((*melody->notes)[melody->current][1]);
+        }
+
+        if (delta < duration) {
+            duration -= delta;
+        } else {
+            // Only way to get here is if it is the last note and
+            // we have completely missed it. Play it for 1ms...
+            duration = 1;
+        }
+
+        audio_do_play_note((*melody->notes)[melody->current][0], duration, priority);
+        melody->duration = duration;
+    }
+}
+
 bool audio_update_state(void) {
+    // the main loop is busy changing the state itself, which only happens while the driver is stopped
+    if (audio_driver_stopped || !audio_run_commands()) {
+        return false;
+    }
+
     if (!playing_note && !playing_melody) {
         return false;
     }
@@ -399,68 +634,9 @@ bool audio_update_state(void) {
     bool     goto_next_note = false;
     uint16_t current_time   = timer_read();
 
-    if (playing_melody) {
-        goto_next_note = timer_elapsed(last_timestamp) >= melody_current_note_duration;
-        if (goto_next_note) {
-            uint16_t delta         = timer_elapsed(last_timestamp) - melody_current_note_duration;
-            last_timestamp         = current_time;
-            uint16_t previous_note = current_note;
-            current_note++;
-            voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
-
-            if (current_note >= notes_count) {
-                if (notes_repeat) {
-                    current_note = 0;
-                } else {
-                    audio_stop_all();
-                    return false;
-                }
-            }
-
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
-                note_resting = true;
-
-                // special handling for successive notes of the same frequency:
-                // insert a short pause to separate them audibly
-                audio_play_note(0.0f, audio_duration_to_ms(2));
-                current_note                 = previous_note;
-                melody_current_note_duration = audio_duration_to_ms(2);
-
-            } else {
-                note_resting = false;
-
-                // TODO: handle glissando here (or remember previous and current tone)
-                /* there would need to be a freq(here we are) -> freq(next note)
-                 * and do slide/glissando in between problem here is to know which
-                 * frequency on the stack relates to what other? e.g. a melody starts
-                 * tones in a sequence, and stops expiring one, so the most recently
-                 * stopped is the starting point for a glissando to the most recently started?
-                 * how to detect and preserve this relation?
-                 * and what about user input, chords, ...?
-                 */
-
-                // '- delta': Skip forward in the next note's length if we've over shot
-                //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
-
-                // Skip forward past any completely missed notes
-                while (delta > duration && current_note < notes_count - 1) {
-                    delta -= duration;
-                    current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
-                }
-
-                if (delta < duration) {
-                    duration -= delta;
-                } else {
-                    // Only way to get here is if it is the last note and
-                    // we have completely missed it. Play it for 1ms...
-                    duration = 1;
-                }
-
-                audio_play_note((*notes_pointer)[current_note][0], duration);
-                melody_current_note_duration = duration;
-            }
+    for (uint8_t i = 0; i < AUDIO_PRIORITY_COUNT && playing_melody; i++) {
+        if (melodies[i].playing) {
+            audio_advance_melody(i, current_time);
         }
     }
 
@@ -475,12 +651,12 @@ bool audio_update_state(void) {
         }
 
         // housekeeping: stop notes that have no playtime left
-        for (int i = 0; i < active_tones; i++) {
+        for (int i = active_tones - 1; i >= 0; i--) {
             if ((tones[i].duration != 0xffff) // indefinitely playing notes, started by 'audio_play_tone'
                 && (tones[i].duration != 0)   // 'uninitialized'
             ) {
                 if (timer_elapsed(tones[i].time_started) >= tones[i].duration) {
-                    audio_stop_tone(tones[i].pitch); // also sets 'state_changed=true'
+                    audio_remove_tone(i); // also sets 'state_changed=true'
                 }
             }
         }
@@ -48,6 +48,19 @@ typedef union {
 #    define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
+/*
+ * sources of sound, from lowest to highest priority: single-tone drivers play
+ * the tone on top of the stack, which is the most recent tone of the highest
+ * priority; each priority level can play one melody at a time
+ */
+typedef enum {
+    AUDIO_PRIORITY_MUSIC,  // music mode, MIDI and tones started through audio_play_tone/_note
+    AUDIO_PRIORITY_MELODY, // SONGs started through PLAY_SONG/PLAY_LOOP
+    AUDIO_PRIORITY_CLICKY, // clicky feedback
+    AUDIO_PRIORITY_NOTIFY, // notifications, e.g. layer or caps lock changes
+    AUDIO_PRIORITY_COUNT,
+} audio_priority_t;
+
 /*
  * a 'musical note' is represented by pitch and duration; a 'musical tone' adds intensity and timbre
  * https://en.wikipedia.org/wiki/Musical_tone
@@ -57,6 +70,7 @@ typedef struct {
     uint16_t time_started; // timestamp the tone/note was started, system time runs with 1ms resolution -> 16bit timer overflows every ~64 seconds, long enough under normal circumstances; but might be too soon for long-duration notes when the note_tempo is set to a very low value
     float    pitch;        // aka frequency, in Hz
     uint16_t duration;     // in ms, converted from the musical_notes.h unit which has 64parts to a beat, factoring in the current tempo in beats-per-minute
+    uint8_t  priority;     // audio_priority_t of the source that started the tone
     // float intensity;    // aka volume [0,1] TODO: not used at the moment; pwm drivers can't handle it
     // uint8_t timbre;     // range: [0,100] TODO: this currently kept track of globally, should we do this per tone instead?
 } musical_tone_t;
@@ -100,6 +114,14 @@ bool audio_is_on(void);
  *                     from the musical_notes.h unit to ms
  */
 void audio_play_note(float pitch, uint16_t duration);
+
+/**
+ * @brief start playback of a tone with the given frequency, duration and priority
+ *
+ * @details like 'audio_play_note', but the tone is put above all tones of a
+ *          lower priority, so single-tone drivers keep playing it until it ends
+ */
+void audio_play_note_with_priority(float pitch, uint16_t duration, audio_priority_t priority);
 // TODO: audio_play_note(float pitch, uint16_t duration, float intensity, float timbre);
 // audio_play_note_with_instrument ifdef AUDIO_ENABLE_VOICES
 
@@ -142,6 +164,20 @@ void audio_stop_tone(float pitch);
  */
 void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
 
+/**
+ * @brief play a melody at the given priority
+ *
+ * @details a melody replaces the one playing at the same priority, but plays
+ *          alongside melodies of other priorities - e.g. a notification
+ *          interrupts a looping song, which carries on once it is over
+ */
+void audio_play_melody_with_priority(float (*np)[][2], uint16_t n_count, bool n_repeat, audio_priority_t priority);
+
+/**
+ * @brief stop the melody, and its tones, of the given priority
+ */
+void audio_stop_melody(audio_priority_t priority);
+
 /**
  * @brief play a short tone of a specific frequency to emulate a 'click'
  *
@@ -188,6 +224,11 @@ bool audio_is_playing_melody(void);
  */
 #define PLAY_LOOP(note_array) audio_play_melody(&note_array, NOTE_ARRAY_SIZE((note_array)), true)
 
+/**
+ * @brief play a SONG above all other melodies, which resume once it is over
+ */
+#define PLAY_NOTIFICATION(note_array) audio_play_melody_with_priority(&note_array, NOTE_ARRAY_SIZE((note_array)), false, AUDIO_PRIORITY_NOTIFY)
+
 // Tone-Multiplexing functions
 // this feature only makes sense for hardware setups which can't do proper
 // audio-wave synthesis = have no DAC and need to use PWM for tone generation
@@ -18,41 +18,15 @@
 #include "led_tables.h"
 #include "progmem.h"
 
-RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+// Converts a saturated colour whose value has already been through the CIE
+// curve. `h * 6 / 255` is computed without a division, which is a library call
+// on AVR and on the Cortex-M0.
+static inline RGB hsv_to_rgb_sector(uint8_t h, uint8_t s, uint8_t v) {
     RGB      rgb;
     uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
-
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
-        return rgb;
-    }
-
-    h = hsv.h;
-    s = hsv.s;
-#ifdef USE_CIE1931_CURVE
-    if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
-    }
-#else
-    v = hsv.v;
-#endif
+    uint16_t h6 = h * 6;
 
-    region    = h * 6 / 255;
+    region    = (h6 + (h6 >> 8) + 1) >> 8;
     remainder = (h * 2 - region * 85) * 3;
 
     p = (v * (255 - s)) >> 8;
@@ -96,6 +70,25 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     return rgb;
 }
 
+static inline uint8_t hsv_value(uint8_t v, bool use_cie) {
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        return pgm_read_byte(&CIE1931_CURVE[v]);
+    }
+#endif
+    return v;
+}
+
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+    uint8_t v = hsv_value(hsv.v, use_cie);
+
+    if (hsv.s == 0) {
+        return (RGB){.r = v, .g = v, .b = v};
+    }
+
+    return hsv_to_rgb_sector(hsv.h, hsv.s, v);
+}
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
@@ -108,6 +101,30 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+void hsv_to_rgb_span(const HSV *hsv, RGB *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    const bool use_cie = true;
+#else
+    const bool use_cie = false;
+#endif
+    // Neighbouring LEDs are often the same colour, so only convert on change
+    HSV last   = {0, 0, 0};
+    RGB result = {0};
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (hsv[i].h != last.h || hsv[i].s != last.s || hsv[i].v != last.v) {
+            last      = hsv[i];
+            uint8_t v = hsv_value(last.v, use_cie);
+            if (last.s == 0 || v == 0) {
+                result = (RGB){.r = v, .g = v, .b = v};
+            } else {
+                result = hsv_to_rgb_sector(last.h, last.s, v);
+            }
+        }
+        rgb[i] = result;
+    }
+}
+
 #ifdef RGBW
 #    ifndef MIN
 #        define MIN(a, b) ((a) < (b) ? (a) : (b))
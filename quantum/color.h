@@ -145,6 +145,9 @@ typedef struct PACKED {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+
+// Converts a whole run of LEDs at once
+void hsv_to_rgb_span(const HSV *hsv, RGB *rgb, uint16_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(LED_TYPE *led);
 #endif
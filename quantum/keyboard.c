@@ -63,6 +63,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef MIDI_ENABLE
 #    include "process_midi.h"
 #endif
+#ifdef AUDIO_SAMPLE_ENABLE
+#    include "audio_dac_sample.h"
+#endif
 #ifdef JOYSTICK_ENABLE
 #    include "process_joystick.h"
 #endif
@@ -530,6 +533,10 @@ void quantum_task(void) {
     music_task();
 #endif
 
+#ifdef AUDIO_SAMPLE_ENABLE
+    audio_sample_task();
+#endif
+
 #ifdef KEY_OVERRIDE_ENABLE
     key_override_task();
 #endif
@@ -584,6 +591,10 @@ void keyboard_task(void) {
     split_watchdog_task();
 #endif
 
+#ifdef LIGHTING_SYNC_ENABLE
+    lighting_sync_task();
+#endif
+
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
 #endif
@@ -153,29 +153,98 @@ uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef LED_MATRIX_HIGH_PRECISION
+// Gamma corrected brightness of every LED, at 16 bits regardless of the driver resolution
+static uint16_t led_value16[LED_MATRIX_LED_COUNT];
+// Part of a PWM step each LED still owes, carried over to the next flush
+static uint16_t led_dither[LED_MATRIX_LED_COUNT];
+
+static uint16_t led_matrix_gamma16(uint16_t value) {
+#    ifdef USE_CIE1931_CURVE_16
+    if (!led_matrix_driver.hardware_gamma) {
+        // Interpolate between the two nearest entries of the curve
+        uint8_t  index = value >> 8;
+        uint16_t lo    = pgm_read_word(&CIE1931_CURVE_16[index]);
+        uint16_t hi    = pgm_read_word(&CIE1931_CURVE_16[index + 1]);
+        value          = lo + (((uint32_t)(hi - lo) * (value & 0xFF)) >> 8);
+    }
+#    endif
+    return value;
+}
+
+/* Reduce the 16-bit framebuffer to the PWM resolution of the driver.
+ *
+ * The bits below the resolution of the driver are accumulated per LED, and every time they
+ * add up to a full step the LED is shown one step brighter for a frame (temporal dithering).
+ * On average the LED then shows its exact 16-bit value. The drivers only transfer the parts
+ * of their PWM buffers that changed, so LEDs that land exactly on a step cost no bus traffic.
+ */
+static void led_matrix_dither(void) {
+    uint8_t bits  = led_matrix_driver.pwm_bits ? led_matrix_driver.pwm_bits : 8;
+    uint8_t shift = 16 - bits;
+
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        // Scale 0-65535 to 0-(max << shift), so a full step of dither never overflows the maximum
+        uint16_t scaled = led_value16[i] - (led_value16[i] >> bits);
+        uint16_t sum    = scaled + led_dither[i];
+        led_dither[i]   = sum & ((1 << shift) - 1);
+
+        if (bits > 8 && led_matrix_driver.set_value16) {
+            led_matrix_driver.set_value16(i, sum >> shift);
+        } else {
+            led_matrix_driver.set_value(i, sum >> shift);
+        }
+    }
+}
+#endif
+
 void led_matrix_update_pwm_buffers(void) {
+#ifdef LED_MATRIX_HIGH_PRECISION
+    led_matrix_dither();
+#endif
     led_matrix_driver.flush();
 }
 
+#ifdef LED_MATRIX_HIGH_PRECISION
+void led_matrix_set_value16(int index, uint16_t value) {
+    if (index < 0 || index >= LED_MATRIX_LED_COUNT) return;
+    led_value16[index] = led_matrix_gamma16(value);
+}
+
+void led_matrix_set_value16_all(uint16_t value) {
+    value = led_matrix_gamma16(value);
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++)
+        led_value16[i] = value;
+}
+
 void led_matrix_set_value(int index, uint8_t value) {
-#ifdef USE_CIE1931_CURVE
+    led_matrix_set_value16(index, value * 257);
+}
+
+void led_matrix_set_value_all(uint8_t value) {
+    led_matrix_set_value16_all(value * 257);
+}
+#else
+void led_matrix_set_value(int index, uint8_t value) {
+#    ifdef USE_CIE1931_CURVE
     value = pgm_read_byte(&CIE1931_CURVE[value]);
-#endif
+#    endif
     led_matrix_driver.set_value(index, value);
 }
 
 void led_matrix_set_value_all(uint8_t value) {
-#if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
     for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++)
         led_matrix_set_value(i, value);
-#else
-#    ifdef USE_CIE1931_CURVE
-    led_matrix_driver.set_value_all(pgm_read_byte(&CIE1931_CURVE[value]));
 #    else
+#        ifdef USE_CIE1931_CURVE
+    led_matrix_driver.set_value_all(pgm_read_byte(&CIE1931_CURVE[value]));
+#        else
     led_matrix_driver.set_value_all(value);
+#        endif
 #    endif
-#endif
 }
+#endif
 
 void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef LED_MATRIX_SPLIT
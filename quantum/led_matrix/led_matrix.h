@@ -112,6 +112,10 @@ uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 
 void led_matrix_set_value(int index, uint8_t value);
 void led_matrix_set_value_all(uint8_t value);
+#ifdef LED_MATRIX_HIGH_PRECISION
+void led_matrix_set_value16(int index, uint16_t value);
+void led_matrix_set_value16_all(uint16_t value);
+#endif
 
 void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
 
@@ -173,6 +177,15 @@ typedef struct {
     void (*set_value_all)(uint8_t value);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
+
+    /* The members below are optional, and only used with LED_MATRIX_HIGH_PRECISION. */
+
+    /* PWM resolution of the driver in bits, 8 if left unset. */
+    uint8_t pwm_bits;
+    /* Set the brightness of a single LED in the buffer, using the full PWM resolution. Required if pwm_bits is above 8. */
+    void (*set_value16)(int index, uint16_t value);
+    /* The driver applies its own gamma correction, so the CIE curve is skipped. */
+    bool hardware_gamma;
 } led_matrix_driver_t;
 
 static inline bool led_matrix_check_finished_leds(uint8_t led_idx) {
@@ -21,3 +21,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef USE_CIE1931_CURVE
 extern const uint8_t CIE1931_CURVE[] PROGMEM;
 #endif
+
+#if defined(USE_CIE1931_CURVE) && defined(LED_MATRIX_HIGH_PRECISION)
+#    define USE_CIE1931_CURVE_16
+#endif
+
+#ifdef USE_CIE1931_CURVE_16
+extern const uint16_t CIE1931_CURVE_16[] PROGMEM;
+#endif
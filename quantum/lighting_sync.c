@@ -0,0 +1,54 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "lighting_sync.h"
+#include "sync_timer.h"
+#include "timer.h"
+
+#include <stdint.h>
+
+static uint32_t              frame_timer;
+static bool                  frame_started = false;
+static uint8_t               queued_count  = 0;
+static lighting_flush_func_t queued[LIGHTING_SYNC_MAX_FLUSHES];
+
+void lighting_sync_task(void) {
+    frame_started = false;
+    if (sync_timer_elapsed32(frame_timer) < LIGHTING_SYNC_INTERVAL) {
+        return;
+    }
+
+    // the next frame is timed from now, so a late frame never makes the
+    // front-ends' own flush limits skip the following one
+    frame_timer   = sync_timer_read32();
+    frame_started = true;
+    lighting_sync_flush();
+}
+
+bool lighting_sync_frame_started(void) {
+    return frame_started;
+}
+
+void lighting_sync_queue_flush(lighting_flush_func_t flush) {
+    for (uint8_t i = 0; i < queued_count; i++) {
+        if (queued[i] == flush) {
+            return;
+        }
+    }
+
+    if (queued_count == LIGHTING_SYNC_MAX_FLUSHES) {
+        // no room to defer it, send it now rather than drop it
+        flush();
+        return;
+    }
+
+    queued[queued_count++] = flush;
+}
+
+void lighting_sync_flush(void) {
+    // the drivers are flushed back to back, in the order they were queued
+    for (uint8_t i = 0; i < queued_count; i++) {
+        queued[i]();
+    }
+    queued_count = 0;
+}
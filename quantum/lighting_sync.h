@@ -0,0 +1,42 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifndef LIGHTING_SYNC_INTERVAL
+#    define LIGHTING_SYNC_INTERVAL 16
+#endif
+
+#ifndef LIGHTING_SYNC_MAX_FLUSHES
+#    define LIGHTING_SYNC_MAX_FLUSHES 4
+#endif
+
+/**
+ * @typedef Sends a lighting front-end's buffers to its LED driver.
+ */
+typedef void (*lighting_flush_func_t)(void);
+
+/**
+ * @brief Starts a new frame every LIGHTING_SYNC_INTERVAL milliseconds, sending
+ * the buffers queued during the previous frame first. Runs once per
+ * keyboard_task(), before the lighting tasks.
+ */
+void lighting_sync_task(void);
+
+/**
+ * @brief Returns true during the keyboard_task() iteration a new frame started in.
+ */
+bool lighting_sync_frame_started(void);
+
+/**
+ * @brief Queues a flush for the start of the next frame. Queueing the same
+ * function again before then only sends the buffers once.
+ */
+void lighting_sync_queue_flush(lighting_flush_func_t flush);
+
+/**
+ * @brief Sends the queued buffers immediately, e.g. before suspending.
+ */
+void lighting_sync_flush(void);
@@ -25,7 +25,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
 
-#    define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#    define ROWS_PER_HAND (SPLIT_LOCAL_ROWS)
 #else
 #    define ROWS_PER_HAND (MATRIX_ROWS)
 #endif
@@ -293,8 +293,13 @@ void matrix_init(void) {
 #    endif
     }
 
+#    ifdef SPLIT_NODE_ID
+    thisHand = SPLIT_NODE_ROW_OFFSET((SPLIT_NODE_ID) - 1);
+    thatHand = 0;
+#    else
     thisHand = isLeftHand ? 0 : (ROWS_PER_HAND);
     thatHand = ROWS_PER_HAND - thisHand;
+#    endif
 #endif
 
     // initialize key pins
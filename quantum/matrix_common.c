@@ -9,7 +9,7 @@
 #    include "split_common/transactions.h"
 #    include <string.h>
 
-#    define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#    define ROWS_PER_HAND (SPLIT_LOCAL_ROWS)
 #else
 #    define ROWS_PER_HAND (MATRIX_ROWS)
 #endif
@@ -111,6 +111,10 @@ bool matrix_post_scan(void) {
 
         if (changed) memcpy(matrix + thatHand, slave_matrix, sizeof(slave_matrix));
 
+#    ifdef SPLIT_EXTRA_NODES
+        changed |= transport_master_nodes(matrix + SPLIT_NODE_ROW_OFFSET(0));
+#    endif // SPLIT_EXTRA_NODES
+
         matrix_scan_quantum();
     } else {
         transport_slave(matrix + thatHand, matrix + thisHand);
@@ -148,8 +152,13 @@ __attribute__((weak)) void matrix_slave_scan_user(void) {}
 
 __attribute__((weak)) void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
+#    ifdef SPLIT_NODE_ID
+    thisHand = SPLIT_NODE_ROW_OFFSET((SPLIT_NODE_ID) - 1);
+    thatHand = 0;
+#    else
     thisHand = isLeftHand ? 0 : (ROWS_PER_HAND);
     thatHand = ROWS_PER_HAND - thisHand;
+#    endif
 #endif
 
     matrix_init_custom();
@@ -56,6 +56,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 32
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether a second pixel data buffer is used, so that the next block of pixel data can be prepared
+ *      while the previous one is still being transmitted in the background. Doubles the RAM used by
+ *      \ref QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER TRUE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -432,9 +441,9 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Drivers
 
-#ifdef QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
-#    include "qp_rgb565_surface.h"
-#endif // QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+#    include "qp_surface.h"
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
 #ifdef QUANTUM_PAINTER_ILI9163_ENABLE
 #    include "qp_ili9163.h"
@@ -9,8 +9,17 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
-// Global variable used for native pixel data streaming.
-extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+// Global variable used for native pixel data streaming. With double buffering, this points at the buffer currently
+// being prepared, while the other one may still be in the process of being transmitted.
+extern uint8_t *qp_internal_global_pixdata_buffer;
+
+// Transmits the first pixels of the global pixdata buffer, then swaps buffers so the next pixels can be prepared while
+// these are still being transmitted.
+bool qp_internal_send_pixdata_buffer(painter_device_t device, uint32_t native_pixel_count);
+
+// Whether the supplied data is a pixdata buffer which is left alone until after the next one is transmitted, so comms
+// may transmit it in the background.
+bool qp_internal_pixdata_can_send_async(const void *data);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -19,8 +19,13 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //       **** very likely get artifacts rendered to the screen as a result.                                       ****
 //
 
-// Buffer used for transmitting native pixel data to the downstream device.
-__attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+// Buffers used for transmitting native pixel data to the downstream device.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#else
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[1][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+uint8_t *qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -47,6 +52,27 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y)
     return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
 }
 
+// Transmits the global pixdata buffer, and moves on to the other one if double buffered
+bool qp_internal_send_pixdata_buffer(painter_device_t device, uint32_t native_pixel_count) {
+    struct painter_driver_t *driver = (struct painter_driver_t *)device;
+    bool                     ret    = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+#endif
+    return ret;
+}
+
+// Only the buffer not being prepared can be in flight. Drawing routines which fill the buffer once and transmit it
+// repeatedly don't swap, but they only fill it at the start of the operation -- after the previous operation stopped
+// comms, which waits for any transfer to complete.
+bool qp_internal_pixdata_can_send_async(const void *data) {
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    return data == qp_internal_pixdata_buffers[0] || data == qp_internal_pixdata_buffers[1];
+#else
+    return false;
+#endif
+}
+
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val) {
     struct painter_driver_t *driver            = (struct painter_driver_t *)device;
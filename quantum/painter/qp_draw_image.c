@@ -268,7 +268,7 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
 
     // Any leftovers need transmission as well.
     if (ret && output_state.pixel_write_pos > 0) {
-        ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+        ret &= qp_internal_send_pixdata_buffer(device, output_state.pixel_write_pos);
     }
 
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
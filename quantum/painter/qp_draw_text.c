@@ -369,7 +369,7 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Any leftovers need transmission as well.
     if (ret && state->output_state->pixel_write_pos > 0) {
-        ret &= driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->output_state->pixel_write_pos);
+        ret &= qp_internal_send_pixdata_buffer(state->device, state->output_state->pixel_write_pos);
     }
 
     return ret;
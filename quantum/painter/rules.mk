@@ -5,6 +5,10 @@ QUANTUM_PAINTER_ANIMATIONS_ENABLE ?= yes
 # The list of permissible drivers that can be listed in QUANTUM_PAINTER_DRIVERS
 VALID_QUANTUM_PAINTER_DRIVERS := \
 	rgb565_surface \
+	rgb888_surface \
+	mono1bpp_surface \
+	gray4bpp_surface \
+	palette8bpp_surface \
 	ili9163_spi \
 	ili9341_spi \
 	ili9488_spi \
@@ -22,6 +26,7 @@ SRC += \
     $(QUANTUM_DIR)/unicode/utf8.c \
     $(QUANTUM_DIR)/color.c \
     $(QUANTUM_DIR)/painter/qp.c \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
     $(QUANTUM_DIR)/painter/qp_stream.c \
     $(QUANTUM_DIR)/painter/qgf.c \
     $(QUANTUM_DIR)/painter/qff.c \
@@ -41,6 +46,9 @@ endif
 # Comms flags
 QUANTUM_PAINTER_NEEDS_COMMS_SPI ?= no
 
+# Surface flags
+QUANTUM_PAINTER_NEEDS_SURFACE ?= no
+
 # Handler for each driver
 define handle_quantum_painter_driver
     CURRENT_PAINTER_DRIVER := $1
@@ -49,11 +57,34 @@ define handle_quantum_painter_driver
         $$(error "$$(CURRENT_PAINTER_DRIVER)" is not a valid Quantum Painter driver)
 
     else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),rgb565_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
         OPT_DEFS += -DQUANTUM_PAINTER_RGB565_SURFACE_ENABLE
-        COMMON_VPATH += \
-            $(DRIVER_PATH)/painter/generic
         SRC += \
-            $(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c \
+            $(DRIVER_PATH)/painter/generic/qp_surface_rgb565.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),rgb888_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_surface_rgb888.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),mono1bpp_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_surface_mono1bpp.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),gray4bpp_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_GRAY4BPP_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_surface_gray4bpp.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),palette8bpp_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_PALETTE8BPP_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_surface_palette8bpp.c \
 
     else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),ili9163_spi)
         QUANTUM_PAINTER_NEEDS_COMMS_SPI := yes
@@ -138,13 +169,20 @@ endef
 # Iterate through the listed drivers for the build, including what's necessary
 $(foreach qp_driver,$(QUANTUM_PAINTER_DRIVERS),$(eval $(call handle_quantum_painter_driver,$(qp_driver))))
 
+# If any surface is used, set up the shared implementation
+ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_SURFACE)), yes)
+    OPT_DEFS += -DQUANTUM_PAINTER_SURFACE_ENABLE
+    COMMON_VPATH += $(DRIVER_PATH)/painter/generic
+    SRC += \
+        $(DRIVER_PATH)/painter/generic/qp_surface_common.c
+endif
+
 # If SPI comms is needed, set up the required files
 ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI)), yes)
     OPT_DEFS += -DQUANTUM_PAINTER_SPI_ENABLE
     QUANTUM_LIB_SRC += spi_master.c
     VPATH += $(DRIVER_PATH)/painter/comms
     SRC += \
-        $(QUANTUM_DIR)/painter/qp_comms.c \
         $(DRIVER_PATH)/painter/comms/qp_comms_spi.c
 
     ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET)), yes)
@@ -34,6 +34,10 @@ void process_midi_all_notes_off(void) {
     midi_send_cc(&midi_device, 0, 0x7B, 0);
 }
 
+void process_midi_basic_realtime(uint8_t status) {
+    midi_send_byte(&midi_device, status);
+}
+
 #    endif // MIDI_BASIC
 
 #    ifdef MIDI_ADVANCED
@@ -252,6 +256,7 @@ bool process_midi(uint16_t keycode, keyrecord_t *record) {
 
 void midi_task(void) {
     midi_device_process(&midi_device);
+    midi_tx_task();
 #    ifdef MIDI_ADVANCED
     if (timer_elapsed(midi_modulation_timer) < midi_config.modulation_interval) return;
     midi_modulation_timer = timer_read();
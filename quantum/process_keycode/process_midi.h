@@ -24,6 +24,7 @@
 void process_midi_basic_noteon(uint8_t note);
 void process_midi_basic_noteoff(uint8_t note);
 void process_midi_all_notes_off(void);
+void process_midi_basic_realtime(uint8_t status);
 #    endif
 
 void midi_task(void);
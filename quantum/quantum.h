@@ -57,6 +57,10 @@
 #    include "deferred_exec.h"
 #endif
 
+#ifdef LIGHTING_SYNC_ENABLE
+#    include "lighting_sync.h"
+#endif
+
 extern layer_state_t default_layer_state;
 
 #ifndef NO_ACTION_LAYER
@@ -1,5 +1,5 @@
 #ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
-RGB_MATRIX_EFFECT(ALPHAS_MODS)
+RGB_MATRIX_EFFECT(ALPHAS_MODS, STATIC)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 // alphas = color1, mods = color2
@@ -0,0 +1,26 @@
+#pragma once
+
+typedef HSV (*dist_angle_f)(HSV hsv, uint8_t dist, uint8_t angle, uint8_t time);
+
+// Effects that only use the angle pass need_dist = false, which skips the sqrt16() per LED when the geometry isn't cached
+bool effect_runner_dist_angle(effect_params_t* params, bool need_dist, dist_angle_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    rgb_hsv_span_t span = {.count = 0};
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+#ifdef RGB_MATRIX_LED_GEOMETRY
+        uint8_t dist  = g_led_geometry[i].dist;
+        uint8_t angle = g_led_geometry[i].angle;
+#else
+        int16_t dx    = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy    = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        uint8_t dist  = need_dist ? sqrt16(dx * dx + dy * dy) : 0;
+        uint8_t angle = atan2_8(dy, dx);
+#endif
+        rgb_matrix_span_push(&span, i, effect_func(rgb_matrix_config.hsv, dist, angle, time));
+    }
+    rgb_matrix_span_flush(&span);
+    return rgb_matrix_check_finished_leds(led_max);
+}
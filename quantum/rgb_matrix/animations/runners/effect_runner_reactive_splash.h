@@ -4,8 +4,13 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
+// Returns the range of distances from a hit that effect_func can still light at
+// the given tick, or false once the hit no longer lights anything
+typedef bool (*reactive_splash_range_f)(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist);
+
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    rgb_hsv_span_t span = {.count = 0};
 
     uint8_t count = g_last_hit_tracker.count;
     for (uint8_t i = led_min; i < led_max; i++) {
@@ -19,11 +24,64 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
             uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
             hsv           = effect_func(hsv, dx, dy, dist, tick);
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_span_push(&span, i, hsv);
     }
+    rgb_matrix_span_flush(&span);
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+// As effect_runner_reactive_splash(), but only calls effect_func for the LEDs
+// within the range of distances reported by range_func for each hit. Hits that
+// have moved past every LED are dropped before the LEDs are visited, and LEDs
+// outside a hit's ring are rejected with integer compares instead of sqrt16().
+bool effect_runner_reactive_splash_range(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_range_f range_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    rgb_hsv_span_t span = {.count = 0};
+
+    uint8_t  count = 0;
+    uint8_t  hit[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    uint8_t  min_dist[LED_HITS_TO_REMEMBER];
+    uint8_t  max_dist[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+        uint16_t t = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        if (range_func(t, &min_dist[count], &max_dist[count])) {
+            hit[count]  = j;
+            tick[count] = t;
+            count++;
+        }
+    }
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        HSV hsv = rgb_matrix_config.hsv;
+        hsv.v   = 0;
+        for (uint8_t k = 0; k < count; k++) {
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[hit[k]];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[hit[k]];
+            int16_t ax = dx < 0 ? -dx : dx;
+            int16_t ay = dy < 0 ? -dy : dy;
+            // outside the bounding square of the ring, or inside the diamond within its hole
+            if (ax > max_dist[k] || ay > max_dist[k] || ax + ay < min_dist[k]) continue;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist < min_dist[k] || dist > max_dist[k]) continue;
+            hsv = effect_func(hsv, dx, dy, dist, tick[k]);
+        }
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_span_push(&span, i, hsv);
+    }
+    rgb_matrix_span_flush(&span);
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+// Range of the expanding ring lit by effects where `effect = tick - dist` must
+// stay below 255
+bool reactive_splash_ring_range(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    if (tick > 254 + UINT8_MAX) return false;
+    *min_dist = tick > 254 ? tick - 254 : 0;
+    *max_dist = tick > UINT8_MAX ? UINT8_MAX : tick;
+    return true;
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
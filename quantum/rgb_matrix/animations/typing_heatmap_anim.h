@@ -13,34 +13,100 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+// Keys that may hold a non-zero heat value, so the decay pass can skip the rest
+static matrix_row_t heatmap_active[MATRIX_ROWS];
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// Several keys may share an LED, so there can be more keys with an LED than LEDs
+#            define HEATMAP_KEY_COUNT (MATRIX_ROWS * MATRIX_COLS)
+
+typedef struct PACKED {
+    uint8_t row;
+    uint8_t col;
+} heatmap_key_t;
+
+// Keys with an LED, sorted by the x position of their LED so the keys within
+// the spread of a keypress are found without scanning the whole matrix
+static heatmap_key_t heatmap_keys[HEATMAP_KEY_COUNT];
+static uint16_t      heatmap_key_count = 0;
+
+static inline led_point_t heatmap_key_point(uint16_t k) {
+    return g_led_config.point[g_led_config.matrix_co[heatmap_keys[k].row][heatmap_keys[k].col]];
+}
+
+static void heatmap_sort_keys(void) {
+    heatmap_key_count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS && heatmap_key_count < HEATMAP_KEY_COUNT; col++) {
+            if (g_led_config.matrix_co[row][col] == NO_LED) {
+                continue;
+            }
+            uint8_t  x = g_led_config.point[g_led_config.matrix_co[row][col]].x;
+            uint16_t k = heatmap_key_count++;
+            while (k > 0 && heatmap_key_point(k - 1).x > x) {
+                heatmap_keys[k] = heatmap_keys[k - 1];
+                k--;
+            }
+            heatmap_keys[k].row = row;
+            heatmap_keys[k].col = col;
+        }
+    }
+}
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
     g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
+    heatmap_active[row] |= MATRIX_ROW_SHIFTER << col;
 #        else
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
-    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
-        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+    if (heatmap_key_count == 0) {
+        heatmap_sort_keys();
+    }
+    led_point_t pressed = g_led_config.point[g_led_config.matrix_co[row][col]];
+
+    // binary search for the first key within the spread to the left of the pressed key
+    int16_t  min_x = pressed.x - RGB_MATRIX_TYPING_HEATMAP_SPREAD;
+    uint16_t first = 0;
+    uint16_t last  = heatmap_key_count;
+    while (first < last) {
+        uint16_t mid = (first + last) / 2;
+        if (heatmap_key_point(mid).x < min_x) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+
+    for (uint16_t k = first; k < heatmap_key_count; k++) {
+        uint8_t     i_row  = heatmap_keys[k].row;
+        uint8_t     i_col  = heatmap_keys[k].col;
+        led_point_t target = heatmap_key_point(k);
+        int16_t     dx     = target.x - pressed.x;
+        int16_t     dy     = target.y - pressed.y;
+        if (dx > RGB_MATRIX_TYPING_HEATMAP_SPREAD) { // all remaining keys are further to the right
+            break;
+        }
+        if (i_row == row && i_col == col) {
+            g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
+        } else {
+            if (dy > RGB_MATRIX_TYPING_HEATMAP_SPREAD || dy < -RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
                 continue;
             }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t distance = sqrt16(dx * dx + dy * dy);
+            if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                continue;
+            }
+            uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+            if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
             }
+            g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
         }
+        heatmap_active[i_row] |= MATRIX_ROW_SHIFTER << i_col;
     }
 #        endif
 }
@@ -56,10 +122,14 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        memset(heatmap_active, 0, sizeof heatmap_active);
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+        heatmap_sort_keys();
+#        endif
     }
 
     // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
+    // `RGB_MATRIX_LED_CHUNK_SIZE`, therefore we only want to update the
     // timer when the animation starts.
     if (params->iter == 0) {
         decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
@@ -72,12 +142,16 @@ bool TYPING_HEATMAP(effect_params_t* params) {
 
     // Render heatmap & decrease
     uint8_t count = 0;
-    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
+    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_CHUNK_SIZE; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS && count < RGB_MATRIX_LED_CHUNK_SIZE; col++) {
             if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
                 count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
                 if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
+                if (!(heatmap_active[row] & (MATRIX_ROW_SHIFTER << col))) { // cold key, nothing to decay
+                    rgb_matrix_set_color(g_led_config.matrix_co[row][col], 0, 0, 0);
+                    continue;
+                }
+                uint8_t val = g_rgb_frame_buffer[row][col];
 
                 HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
                 RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -85,6 +159,9 @@ bool TYPING_HEATMAP(effect_params_t* params) {
 
                 if (decrease_heatmap_values) {
                     g_rgb_frame_buffer[row][col] = qsub8(val, 1);
+                    if (val <= 1) {
+                        heatmap_active[row] &= ~(MATRIX_ROW_SHIFTER << col);
+                    }
                 }
             }
         }
@@ -25,22 +25,64 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_FLUSH_ASYNC
+#    include "async_flush.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
-__attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+#ifndef RGB_MATRIX_HSV_SPAN_SIZE
+#    define RGB_MATRIX_HSV_SPAN_SIZE 8
+#endif
+
+static RGB rgb_matrix_hsv_to_rgb_default(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) __attribute__((weak, alias("rgb_matrix_hsv_to_rgb_default")));
+
+// Colours queued by the effect runners, converted together once the span fills
+typedef struct {
+    uint8_t count;
+    uint8_t led[RGB_MATRIX_HSV_SPAN_SIZE];
+    HSV     hsv[RGB_MATRIX_HSV_SPAN_SIZE];
+} rgb_hsv_span_t;
+
+static void rgb_matrix_span_flush(rgb_hsv_span_t *span) {
+    RGB rgb[RGB_MATRIX_HSV_SPAN_SIZE];
+
+    // Keyboards overriding rgb_matrix_hsv_to_rgb() still get called per LED
+    if (rgb_matrix_hsv_to_rgb == rgb_matrix_hsv_to_rgb_default) {
+        hsv_to_rgb_span(span->hsv, rgb, span->count);
+    } else {
+        for (uint8_t j = 0; j < span->count; j++) {
+            rgb[j] = rgb_matrix_hsv_to_rgb(span->hsv[j]);
+        }
+    }
+    for (uint8_t j = 0; j < span->count; j++) {
+        rgb_matrix_set_color(span->led[j], rgb[j].r, rgb[j].g, rgb[j].b);
+    }
+    span->count = 0;
+}
+
+static inline void rgb_matrix_span_push(rgb_hsv_span_t *span, uint8_t led, HSV hsv) {
+    span->led[span->count] = led;
+    span->hsv[span->count] = hsv;
+    if (++span->count == RGB_MATRIX_HSV_SPAN_SIZE) {
+        rgb_matrix_span_flush(span);
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
-#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_EFFECT(name, ...)
 #define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #include "rgb_matrix_effects.inc"
@@ -106,6 +148,19 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
 #    define RGB_MATRIX_DEFAULT_SPD UINT8_MAX / 2
 #endif
 
+#ifdef RGB_MATRIX_GOVERNOR
+#    if !defined(RGB_MATRIX_GOVERNOR_SCAN_RATE)
+#        define RGB_MATRIX_GOVERNOR_SCAN_RATE 1000
+#    endif
+#    if !defined(RGB_MATRIX_GOVERNOR_TARGET_FPS)
+#        define RGB_MATRIX_GOVERNOR_TARGET_FPS (1000 / RGB_MATRIX_LED_FLUSH_LIMIT)
+#    endif
+#    if !defined(RGB_MATRIX_GOVERNOR_MAX_FLUSH_INTERVAL)
+#        define RGB_MATRIX_GOVERNOR_MAX_FLUSH_INTERVAL 100
+#    endif
+#    define RGB_MATRIX_GOVERNOR_FLUSH_INTERVAL (1000 / RGB_MATRIX_GOVERNOR_TARGET_FPS)
+#endif
+
 // globals
 rgb_config_t rgb_matrix_config; // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
 uint32_t     g_rgb_timer;
@@ -115,6 +170,13 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_LED_GEOMETRY
+led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_LED_GEOMETRY
+#ifdef RGB_MATRIX_GOVERNOR
+// 0 or anything from the LED count up means rendering the whole matrix in one go
+uint8_t g_rgb_led_process_limit = (RGB_MATRIX_LED_PROCESS_LIMIT) > 0 && (RGB_MATRIX_LED_PROCESS_LIMIT) < RGB_MATRIX_LED_COUNT ? (RGB_MATRIX_LED_PROCESS_LIMIT) : RGB_MATRIX_LED_COUNT;
+#endif // RGB_MATRIX_GOVERNOR
 
 // internals
 static bool            suspend_state     = false;
@@ -125,6 +187,45 @@ static rgb_task_states rgb_task_state    = SYNCING;
 #if RGB_MATRIX_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
+#ifdef RGB_MATRIX_GOVERNOR
+static uint8_t            rgb_flush_interval = RGB_MATRIX_GOVERNOR_FLUSH_INTERVAL;
+static uint8_t            rgb_effect_limit[RGB_MATRIX_EFFECT_MAX]; // learned process limit of each effect, 0 if unknown
+static uint32_t           rgb_frame_start;
+static uint16_t           rgb_task_runs;
+static uint16_t           rgb_render_runs;
+static uint16_t           rgb_render_time;
+static rgb_matrix_stats_t rgb_stats = {0};
+#endif // RGB_MATRIX_GOVERNOR
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+static uint32_t     rgb_frame_hash;           // hash of every LED write since the frame started
+static uint32_t     rgb_flushed_hash;         // hash of the last frame sent to the driver
+static uint16_t     rgb_frame_writes;         // LED writes since the frame started
+static bool         rgb_frame_reused;         // the effect was not rendered, the previous frame was kept
+static bool         rgb_indicators_drew;      // indicators wrote LEDs during the current frame
+static bool         rgb_last_indicators_drew; // indicators wrote LEDs during the last flushed frame
+static rgb_config_t rgb_rendered_config;      // configuration the last frame was rendered with
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+typedef struct {
+    uint8_t min; // first changed LED
+    uint8_t max; // one past the last changed LED, equal to min when nothing changed
+} rgb_dirty_t;
+
+typedef struct {
+    RGB         color[RGB_MATRIX_LED_COUNT];
+    uint8_t     lit[(RGB_MATRIX_LED_COUNT + 7) / 8];
+    uint8_t     blend;
+    uint8_t     alpha;
+    rgb_dirty_t dirty;
+} rgb_overlay_t;
+
+static RGB           rgb_base[RGB_MATRIX_LED_COUNT];       // colors written by the effect and indicators
+static RGB           rgb_composited[RGB_MATRIX_LED_COUNT]; // colors last written to the driver
+static rgb_dirty_t   rgb_base_dirty;
+static rgb_overlay_t rgb_overlays[RGB_MATRIX_OVERLAY_COUNT];
+static bool          rgb_overlays_shown;
+static bool          rgb_composite_pending; // the driver buffers changed since the last flush
+#endif // RGB_MATRIX_OVERLAY_COUNT
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -192,15 +293,174 @@ void rgb_matrix_update_pwm_buffers(void) {
     rgb_matrix_driver.flush();
 }
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+static inline void rgb_frame_hash_write(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    // djb2, which only needs shifts and adds
+    rgb_frame_hash = (rgb_frame_hash << 5) + rgb_frame_hash + index;
+    rgb_frame_hash = (rgb_frame_hash << 5) + rgb_frame_hash + red;
+    rgb_frame_hash = (rgb_frame_hash << 5) + rgb_frame_hash + green;
+    rgb_frame_hash = (rgb_frame_hash << 5) + rgb_frame_hash + blue;
+    rgb_frame_writes++;
+}
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+static inline void rgb_dirty_add(rgb_dirty_t *dirty, uint8_t index) {
+    if (dirty->min == dirty->max) {
+        dirty->min = index;
+        dirty->max = index + 1;
+    } else if (index < dirty->min) {
+        dirty->min = index;
+    } else if (index >= dirty->max) {
+        dirty->max = index + 1;
+    }
+}
+
+static inline void rgb_dirty_merge(rgb_dirty_t *dirty, const rgb_dirty_t *other) {
+    if (other->min == other->max) return;
+    if (dirty->min == dirty->max) {
+        *dirty = *other;
+        return;
+    }
+    if (other->min < dirty->min) dirty->min = other->min;
+    if (other->max > dirty->max) dirty->max = other->max;
+}
+
+static inline bool rgb_overlay_is_lit(const rgb_overlay_t *overlay, uint8_t index) {
+    return overlay->lit[index / 8] & (1 << (index % 8));
+}
+
+static void rgb_base_set_color(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= RGB_MATRIX_LED_COUNT) return;
+    RGB *rgb = &rgb_base[index];
+    if (rgb->r != red || rgb->g != green || rgb->b != blue) {
+        rgb->r = red;
+        rgb->g = green;
+        rgb->b = blue;
+        rgb_dirty_add(&rgb_base_dirty, index);
+    }
+}
+
+void rgb_matrix_overlay_set_color(uint8_t overlay, uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT || index >= RGB_MATRIX_LED_COUNT) return;
+    rgb_overlay_t *o   = &rgb_overlays[overlay];
+    RGB           *rgb = &o->color[index];
+    if (!rgb_overlay_is_lit(o, index) || rgb->r != red || rgb->g != green || rgb->b != blue) {
+        rgb->r = red;
+        rgb->g = green;
+        rgb->b = blue;
+        o->lit[index / 8] |= 1 << (index % 8);
+        rgb_dirty_add(&o->dirty, index);
+    }
+}
+
+void rgb_matrix_overlay_clear_color(uint8_t overlay, uint8_t index) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT || index >= RGB_MATRIX_LED_COUNT) return;
+    rgb_overlay_t *o = &rgb_overlays[overlay];
+    if (rgb_overlay_is_lit(o, index)) {
+        o->lit[index / 8] &= ~(1 << (index % 8));
+        rgb_dirty_add(&o->dirty, index);
+    }
+}
+
+void rgb_matrix_overlay_clear(uint8_t overlay) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    rgb_overlay_t *o = &rgb_overlays[overlay];
+    for (uint8_t i = 0; i < sizeof(o->lit); i++) {
+        if (!o->lit[i]) continue;
+        rgb_dirty_add(&o->dirty, i * 8);
+        rgb_dirty_add(&o->dirty, MIN(i * 8 + 7, RGB_MATRIX_LED_COUNT - 1));
+        o->lit[i] = 0;
+    }
+}
+
+void rgb_matrix_overlay_set_blend(uint8_t overlay, rgb_matrix_blend_t blend, uint8_t alpha) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    rgb_overlay_t *o = &rgb_overlays[overlay];
+    if (o->blend != blend || o->alpha != alpha) {
+        o->blend = blend;
+        o->alpha = alpha;
+        o->dirty = (rgb_dirty_t){0, RGB_MATRIX_LED_COUNT};
+    }
+}
+
+static RGB rgb_overlay_blend(const rgb_overlay_t *overlay, uint8_t index, RGB below) {
+    RGB over = overlay->color[index];
+    switch (overlay->blend) {
+        case RGB_MATRIX_BLEND_ADD:
+            below.r = qadd8(below.r, scale8(over.r, overlay->alpha));
+            below.g = qadd8(below.g, scale8(over.g, overlay->alpha));
+            below.b = qadd8(below.b, scale8(over.b, overlay->alpha));
+            return below;
+        case RGB_MATRIX_BLEND_MULTIPLY:
+            over.r = scale8(below.r, over.r);
+            over.g = scale8(below.g, over.g);
+            over.b = scale8(below.b, over.b);
+            break;
+        default:
+            break;
+    }
+    below.r = blend8(below.r, over.r, overlay->alpha);
+    below.g = blend8(below.g, over.g, overlay->alpha);
+    below.b = blend8(below.b, over.b, overlay->alpha);
+    return below;
+}
+
+// Composites the LEDs that changed in any layer since the last pass, and only
+// writes the ones whose final color changed to the driver
+static bool rgb_overlay_composite(bool show_overlays) {
+    rgb_dirty_t dirty = rgb_base_dirty;
+    rgb_base_dirty    = (rgb_dirty_t){0, 0};
+    if (show_overlays != rgb_overlays_shown) {
+        rgb_overlays_shown = show_overlays;
+        dirty              = (rgb_dirty_t){0, RGB_MATRIX_LED_COUNT};
+    }
+    for (uint8_t j = 0; j < RGB_MATRIX_OVERLAY_COUNT; j++) {
+        if (show_overlays) rgb_dirty_merge(&dirty, &rgb_overlays[j].dirty);
+        rgb_overlays[j].dirty = (rgb_dirty_t){0, 0};
+    }
+
+    bool changed = false;
+    for (uint8_t i = dirty.min; i < dirty.max; i++) {
+        RGB rgb = rgb_base[i];
+        if (show_overlays) {
+            for (uint8_t j = 0; j < RGB_MATRIX_OVERLAY_COUNT; j++) {
+                if (rgb_overlays[j].alpha && rgb_overlay_is_lit(&rgb_overlays[j], i)) {
+                    rgb = rgb_overlay_blend(&rgb_overlays[j], i, rgb);
+                }
+            }
+        }
+        if (rgb.r != rgb_composited[i].r || rgb.g != rgb_composited[i].g || rgb.b != rgb_composited[i].b) {
+            rgb_composited[i] = rgb;
+            rgb_matrix_driver.set_color(i, rgb.r, rgb.g, rgb.b);
+            changed = true;
+        }
+    }
+    return changed;
+}
+#endif // RGB_MATRIX_OVERLAY_COUNT
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_write(index, red, green, blue);
+#endif
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+    // the effect and indicators draw the base layer, which only reaches the
+    // driver through the composite pass
+    rgb_base_set_color(index, red, green, blue);
+#else
     rgb_matrix_driver.set_color(index, red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || defined(RGB_MATRIX_OVERLAY_COUNT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_write(UINT8_MAX, red, green, blue);
+#    endif
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
@@ -227,10 +487,10 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
     }
 
     if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
+        memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
         last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
     }
 
@@ -306,27 +566,155 @@ static void rgb_task_timers(void) {
 
     // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
+    uint8_t count   = last_hit_buffer.count;
+    uint8_t expired = 0;
     for (uint8_t i = 0; i < count; ++i) {
         if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
+            // hits are stored oldest first, so the expired ones are always at the front
+            expired++;
             continue;
         }
         last_hit_buffer.tick[i] += deltaTime;
     }
+    if (expired) {
+        count -= expired;
+        memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[expired], count);
+        memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[expired], count);
+        memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[expired], count * 2); // 16 bit
+        memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[expired], count);
+        last_hit_buffer.count = count;
+    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
+#ifdef LIGHTING_SYNC_ENABLE
+    // frames only start together with the other lighting, on its clock alone:
+    // g_rgb_timer is only latched a pass later, once the queued buffers were sent
+    if (!lighting_sync_frame_started()) return;
+#    ifdef RGB_MATRIX_GOVERNOR
+    // a longer flush interval skips whole lighting frames
+    static uint8_t frames = 0;
+    if (++frames * LIGHTING_SYNC_INTERVAL < rgb_flush_interval) return;
+    frames = 0;
+#    endif
+    rgb_task_state = STARTING;
+#elif defined(RGB_MATRIX_GOVERNOR)
+    if (sync_timer_elapsed32(g_rgb_timer) >= rgb_flush_interval) rgb_task_state = STARTING;
+#else
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif
+}
+
+#ifdef RGB_MATRIX_GOVERNOR
+static void rgb_governor_update(uint8_t effect) {
+    uint32_t now    = sync_timer_read32();
+    uint32_t period = now - rgb_frame_start;
+
+    if (rgb_stats.mode == effect && period > 0 && rgb_render_runs > 0) {
+        uint32_t render_rate = (uint32_t)rgb_render_runs * 1000 / (rgb_render_time ? rgb_render_time : 1);
+        uint32_t task_rate   = (uint32_t)rgb_task_runs * 1000 / period;
+
+        // Smaller chunks spread the render over more task runs, which keeps
+        // the scan rate up while rendering
+        if (render_rate < RGB_MATRIX_GOVERNOR_SCAN_RATE) {
+            if (g_rgb_led_process_limit > 1) {
+                g_rgb_led_process_limit -= (g_rgb_led_process_limit + 3) / 4;
+            }
+        } else if (render_rate > 2 * RGB_MATRIX_GOVERNOR_SCAN_RATE && g_rgb_led_process_limit < RGB_MATRIX_LED_COUNT) {
+            g_rgb_led_process_limit += (g_rgb_led_process_limit + 3) / 4;
+            if (g_rgb_led_process_limit > RGB_MATRIX_LED_COUNT) g_rgb_led_process_limit = RGB_MATRIX_LED_COUNT;
+        }
+
+        // Once the chunks can't get any smaller, render less often
+        if (task_rate < RGB_MATRIX_GOVERNOR_SCAN_RATE && g_rgb_led_process_limit == 1) {
+            if (rgb_flush_interval < RGB_MATRIX_GOVERNOR_MAX_FLUSH_INTERVAL) rgb_flush_interval++;
+        } else if (task_rate > 2 * RGB_MATRIX_GOVERNOR_SCAN_RATE && rgb_flush_interval > RGB_MATRIX_GOVERNOR_FLUSH_INTERVAL) {
+            rgb_flush_interval--;
+        }
+
+        if (rgb_stats.led_process_limit != g_rgb_led_process_limit || rgb_stats.flush_interval != rgb_flush_interval) {
+            dprintf("rgb_matrix governor: mode %d, %d leds per run, %dms interval, %lu scans/s while rendering\n", effect, g_rgb_led_process_limit, rgb_flush_interval, (unsigned long)render_rate);
+        }
+
+        rgb_stats.fps         = 1000 / period;
+        rgb_stats.render_time = rgb_render_time;
+        rgb_stats.scan_rate   = render_rate > UINT16_MAX ? UINT16_MAX : render_rate;
+    } else if (rgb_stats.mode != effect) {
+        // remember what was learned for the previous effect, and start from
+        // what was learned for the new one
+        if (rgb_stats.mode < RGB_MATRIX_EFFECT_MAX) rgb_effect_limit[rgb_stats.mode] = g_rgb_led_process_limit;
+        if (effect < RGB_MATRIX_EFFECT_MAX && rgb_effect_limit[effect]) g_rgb_led_process_limit = rgb_effect_limit[effect];
+        rgb_flush_interval = RGB_MATRIX_GOVERNOR_FLUSH_INTERVAL;
+        rgb_stats.mode     = effect;
+        rgb_stats.fps      = 0;
+    }
+
+    rgb_stats.led_process_limit = g_rgb_led_process_limit;
+    rgb_stats.flush_interval    = rgb_flush_interval;
+
+    rgb_frame_start = now;
+    rgb_task_runs   = 0;
+    rgb_render_runs = 0;
+}
+
+void rgb_matrix_get_stats(rgb_matrix_stats_t *stats) {
+    *stats = rgb_stats;
+}
+#endif // RGB_MATRIX_GOVERNOR
+
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+// Effects declared as `RGB_MATRIX_EFFECT(name, STATIC)` only depend on the
+// configuration, so they draw the same frame until it changes
+#    define RGB_MATRIX_EFFECT_IS_STATIC(flag) RGB_MATRIX_EFFECT_IS_STATIC_##flag
+#    define RGB_MATRIX_EFFECT_IS_STATIC_ false
+#    define RGB_MATRIX_EFFECT_IS_STATIC_STATIC true
+
+static bool rgb_matrix_effect_is_static(uint8_t effect) {
+    switch (effect) {
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_##name:          \
+            return RGB_MATRIX_EFFECT_IS_STATIC(__VA_ARGS__);
+#    include "rgb_matrix_effects.inc"
+#    undef RGB_MATRIX_EFFECT
+
+#    if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#        define RGB_MATRIX_EFFECT(name, ...) \
+            case RGB_MATRIX_CUSTOM_##name:   \
+                return RGB_MATRIX_EFFECT_IS_STATIC(__VA_ARGS__);
+#        ifdef RGB_MATRIX_CUSTOM_KB
+#            include "rgb_matrix_kb.inc"
+#        endif
+#        ifdef RGB_MATRIX_CUSTOM_USER
+#            include "rgb_matrix_user.inc"
+#        endif
+#        undef RGB_MATRIX_EFFECT
+#    endif
+        default:
+            return false;
+    }
 }
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+
+static void rgb_task_start(uint8_t effect) {
+#ifdef RGB_MATRIX_GOVERNOR
+    // only change the process limit between frames, the effects expect it to
+    // stay the same for every iteration of a frame
+    rgb_governor_update(effect);
+#endif
 
-static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash      = 5381;
+    rgb_frame_writes    = 0;
+    rgb_frame_reused    = false;
+    rgb_indicators_drew = false;
+#endif
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -345,6 +733,29 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    // the previous frame of a static effect can be kept as is, unless
+    // indicators drew over it
+    if (rgb_effect_params.iter == 0) {
+        rgb_frame_reused = !rgb_last_indicators_drew && memcmp(&rgb_rendered_config, &rgb_matrix_config, sizeof(rgb_config_t)) == 0;
+    }
+    rgb_frame_reused = rgb_frame_reused && !rgb_effect_params.init && rgb_matrix_effect_is_static(effect);
+
+    if (rgb_frame_reused) {
+        // step through the LED ranges without rendering, so the indicators
+        // are still called for each of them
+        effect_params_t *params = &rgb_effect_params;
+        RGB_MATRIX_USE_LIMITS(led_min, led_max);
+        (void)params;
+        (void)led_min;
+        rgb_effect_params.iter++;
+        if (!rgb_matrix_check_finished_leds(led_max)) {
+            rgb_task_state = FLUSHING;
+        }
+        return;
+    }
+#endif
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -398,12 +809,57 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+#if defined(RGB_MATRIX_OVERLAY_COUNT)
+    // overlays are hidden along with the effect when the matrix is off
+    if (rgb_overlay_composite(effect != RGB_MATRIX_NONE)) rgb_composite_pending = true;
+    bool unchanged = !rgb_composite_pending;
+#elif defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES)
+    // a kept frame without indicator writes, or a rendered frame identical to
+    // the last one sent, does not need to be sent to the driver again
+    bool unchanged = rgb_frame_reused ? !rgb_indicators_drew : rgb_frame_hash == rgb_flushed_hash;
+#endif
+#if defined(RGB_MATRIX_OVERLAY_COUNT) || defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES)
+    if (unchanged && effect == rgb_last_effect && rgb_matrix_config.enable == rgb_last_enable) {
+#    ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+        rgb_last_indicators_drew = rgb_indicators_drew;
+#    endif
+        rgb_task_state = SYNCING;
+        return;
+    }
+#endif
+
+#if defined(LIGHTING_SYNC_ENABLE)
+    // sent along with the other lighting at the start of the next frame
+    lighting_sync_queue_flush(rgb_matrix_update_pwm_buffers);
+#elif defined(RGB_MATRIX_FLUSH_ASYNC)
+    // hand the pwm buffers to the flush thread, if the previous frame is still
+    // in flight stay in this state and try again on the next task run
+    if (!async_flush_start(rgb_matrix_update_pwm_buffers, NULL)) return;
+#endif
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
+#if !defined(RGB_MATRIX_FLUSH_ASYNC) && !defined(LIGHTING_SYNC_ENABLE)
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#endif
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+    rgb_composite_pending = false;
+#endif
+
+#ifdef RGB_MATRIX_GOVERNOR
+    rgb_render_runs = rgb_task_runs;
+    rgb_render_time = sync_timer_elapsed32(rgb_frame_start);
+#endif
+
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_flushed_hash         = rgb_frame_hash;
+    rgb_last_indicators_drew = rgb_indicators_drew;
+    if (!rgb_frame_reused) rgb_rendered_config = rgb_matrix_config;
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -411,6 +867,9 @@ static void rgb_task_flush(uint8_t effect) {
 
 void rgb_matrix_task(void) {
     rgb_task_timers();
+#ifdef RGB_MATRIX_GOVERNOR
+    rgb_task_runs++;
+#endif
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -424,13 +883,19 @@ void rgb_matrix_task(void) {
 
     switch (rgb_task_state) {
         case STARTING:
-            rgb_task_start();
+            rgb_task_start(effect);
             break;
         case RENDERING:
             rgb_task_render(effect);
             if (effect) {
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+                uint16_t writes = rgb_frame_writes;
+#endif
                 rgb_matrix_indicators();
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+                if (rgb_frame_writes != writes) rgb_indicators_drew = true;
+#endif
             }
             break;
         case FLUSHING:
@@ -460,10 +925,9 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      * and not sure which would be better. Otherwise, this should be called from
      * rgb_task_render, right before the iter++ line.
      */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
-    uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
-    uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;
+#if defined(RGB_MATRIX_LED_PROCESS_CHUNKED)
+    uint8_t min = RGB_MATRIX_LED_CHUNK_SIZE * (params->iter - 1);
+    uint8_t max = RGB_MATRIX_LED_CHUNK_END(min);
 #else
     uint8_t min = 0;
     uint8_t max = RGB_MATRIX_LED_COUNT;
@@ -479,9 +943,30 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_LED_GEOMETRY
+void rgb_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx              = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy              = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_geometry[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif // RGB_MATRIX_LED_GEOMETRY
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_LED_GEOMETRY
+    rgb_matrix_update_geometry();
+#endif // RGB_MATRIX_LED_GEOMETRY
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+    for (uint8_t j = 0; j < RGB_MATRIX_OVERLAY_COUNT; j++) {
+        rgb_overlays[j].alpha = UINT8_MAX;
+    }
+#endif // RGB_MATRIX_OVERLAY_COUNT
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -512,7 +997,16 @@ void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state) { // only run if turning off, and only once
         rgb_task_render(0);        // turn off all LEDs when suspending
-        rgb_task_flush(0);         // and actually flash led state to LEDs
+#    if defined(LIGHTING_SYNC_ENABLE)
+        rgb_task_flush(0);
+        lighting_sync_flush(); // the lighting sync task doesn't run while suspended
+#    elif defined(RGB_MATRIX_FLUSH_ASYNC)
+        async_flush_wait(); // let any frame in flight complete first
+        rgb_task_flush(0);
+        async_flush_wait();
+#    else
+        rgb_task_flush(0); // and actually flash led state to LEDs
+#    endif
     }
     suspend_state = state;
 #endif
@@ -50,20 +50,33 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (RGB_MATRIX_LED_COUNT + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_GOVERNOR)
+// The governor picks the number of LEDs to render per task run at the start of each frame,
+// starting out from RGB_MATRIX_LED_PROCESS_LIMIT
+extern uint8_t g_rgb_led_process_limit;
+#    define RGB_MATRIX_LED_CHUNK_SIZE g_rgb_led_process_limit
+#    define RGB_MATRIX_LED_PROCESS_CHUNKED
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#    define RGB_MATRIX_LED_CHUNK_SIZE RGB_MATRIX_LED_PROCESS_LIMIT
+#    define RGB_MATRIX_LED_PROCESS_CHUNKED
+#else
+#    define RGB_MATRIX_LED_CHUNK_SIZE RGB_MATRIX_LED_COUNT
+#endif
+
+#if defined(RGB_MATRIX_LED_PROCESS_CHUNKED)
+// The end of the last chunk is clamped before being narrowed, min + limit can exceed 255 with larger LED counts
+#    define RGB_MATRIX_LED_CHUNK_END(min) ((min) + RGB_MATRIX_LED_CHUNK_SIZE > RGB_MATRIX_LED_COUNT ? RGB_MATRIX_LED_COUNT : (min) + RGB_MATRIX_LED_CHUNK_SIZE)
 #    if defined(RGB_MATRIX_SPLIT)
 #        define RGB_MATRIX_USE_LIMITS(min, max)                                                   \
-            uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;                            \
-            uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;                                     \
-            if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;                           \
+            uint8_t min                   = RGB_MATRIX_LED_CHUNK_SIZE * params->iter;             \
+            uint8_t max                   = RGB_MATRIX_LED_CHUNK_END(min);                        \
             uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;                                     \
             if (is_keyboard_left() && (max > k_rgb_matrix_split[0])) max = k_rgb_matrix_split[0]; \
             if (!(is_keyboard_left()) && (min < k_rgb_matrix_split[0])) min = k_rgb_matrix_split[0];
 #    else
-#        define RGB_MATRIX_USE_LIMITS(min, max)                        \
-            uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
-            uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
-            if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;
+#        define RGB_MATRIX_USE_LIMITS(min, max)                     \
+            uint8_t min = RGB_MATRIX_LED_CHUNK_SIZE * params->iter; \
+            uint8_t max = RGB_MATRIX_LED_CHUNK_END(min);
 #    endif
 #else
 #    if defined(RGB_MATRIX_SPLIT)
@@ -138,6 +151,23 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+#ifdef RGB_MATRIX_GOVERNOR
+void rgb_matrix_get_stats(rgb_matrix_stats_t *stats);
+#endif
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+// Overlays are composited over the effect in order, and stay lit until cleared
+void rgb_matrix_overlay_set_color(uint8_t overlay, uint8_t index, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_overlay_clear_color(uint8_t overlay, uint8_t index);
+void rgb_matrix_overlay_clear(uint8_t overlay);
+void rgb_matrix_overlay_set_blend(uint8_t overlay, rgb_matrix_blend_t blend, uint8_t alpha);
+#endif
+
+#ifdef RGB_MATRIX_LED_GEOMETRY
+// Recalculates g_led_geometry, call after modifying g_led_config at runtime
+void rgb_matrix_update_geometry(void);
+#endif
+
 void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -261,6 +291,9 @@ extern led_config_t g_led_config;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
+#ifdef RGB_MATRIX_LED_GEOMETRY
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
@@ -360,7 +360,7 @@ static void init(void) {}
 
 static void flush(void) {
     // Assumes use of RGB_DI_PIN
-    ws2812_setleds(rgb_matrix_ws2812_array, RGB_MATRIX_LED_COUNT);
+    ws2812_setleds_async(rgb_matrix_ws2812_array, RGB_MATRIX_LED_COUNT, NULL);
 }
 
 // Set an led in the buffer to a color
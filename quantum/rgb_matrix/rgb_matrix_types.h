@@ -51,6 +51,25 @@ typedef struct PACKED {
 
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
+#ifdef RGB_MATRIX_GOVERNOR
+typedef struct {
+    uint8_t  mode;              // effect the statistics were measured for
+    uint8_t  led_process_limit; // LEDs rendered per task run
+    uint8_t  flush_interval;    // minimum milliseconds between frames
+    uint16_t fps;               // frames per second
+    uint16_t render_time;       // milliseconds from the start of a frame until it is flushed
+    uint16_t scan_rate;         // task runs, and so matrix scans, per second while rendering
+} rgb_matrix_stats_t;
+#endif // RGB_MATRIX_GOVERNOR
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+typedef enum rgb_matrix_blend_t {
+    RGB_MATRIX_BLEND_NORMAL,   // mixes the overlay over the layers below by its alpha
+    RGB_MATRIX_BLEND_ADD,      // adds the overlay, scaled by its alpha, to the layers below
+    RGB_MATRIX_BLEND_MULTIPLY, // darkens the layers below by the overlay color, scaled by its alpha
+} rgb_matrix_blend_t;
+#endif // RGB_MATRIX_OVERLAY_COUNT
+
 typedef uint8_t led_flags_t;
 
 typedef struct PACKED {
@@ -64,6 +83,13 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+#ifdef RGB_MATRIX_LED_GEOMETRY
+typedef struct PACKED {
+    uint8_t dist;  // distance from k_rgb_matrix_center
+    uint8_t angle; // atan2_8() angle around k_rgb_matrix_center
+} led_geometry_t;
+#endif // RGB_MATRIX_LED_GEOMETRY
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
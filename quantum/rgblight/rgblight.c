@@ -29,6 +29,9 @@
 #ifdef VELOCIKEY_ENABLE
 #    include "velocikey.h"
 #endif
+#ifdef LIGHTING_SYNC_ENABLE
+#    include "lighting_sync.h"
+#endif
 
 #ifndef MIN
 #    define MIN(a, b) (((a) < (b)) ? (a) : (b))
@@ -877,6 +880,10 @@ void rgblight_suspend(void) {
 #    endif
 
         rgblight_disable_noeeprom();
+#    ifdef LIGHTING_SYNC_ENABLE
+        // the lighting sync task doesn't run while suspended
+        lighting_sync_flush();
+#    endif
     }
 }
 
@@ -899,12 +906,12 @@ void rgblight_wakeup(void) {
 #endif
 
 __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num_leds) {
-    ws2812_setleds(start_led, num_leds);
+    ws2812_setleds_async(start_led, num_leds, NULL);
 }
 
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
-void rgblight_set(void) {
+static void rgblight_flush(void) {
     LED_TYPE *start_led;
     uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
 
@@ -948,6 +955,16 @@ void rgblight_set(void) {
 #    endif
     rgblight_call_driver(start_led, num_leds);
 }
+
+void rgblight_set(void) {
+#    ifdef LIGHTING_SYNC_ENABLE
+    // sent along with the other lighting at the start of the next frame, so
+    // effects stepping faster than the frame rate don't flush every step
+    lighting_sync_queue_flush(rgblight_flush);
+#    else
+    rgblight_flush();
+#    endif
+}
 #endif
 
 #ifdef RGBLIGHT_SPLIT
@@ -1186,12 +1203,31 @@ void rgblight_task(void) {
 #        include <rgblight_breathe_table.h>
 #    endif
 
+#    ifndef RGBLIGHT_EFFECT_BREATHE_TABLE
+// Fixed-point constants of the breathing curve, folded by the compiler
+#        define BREATHE_CENTER_Q12 ((int32_t)(RGBLIGHT_EFFECT_BREATHE_CENTER / M_E * 4096 + 0.5))
+#        define BREATHE_SCALE_Q8 ((int32_t)(RGBLIGHT_EFFECT_BREATHE_MAX / (M_E - 1 / M_E) * 256 + 0.5))
+
+// 1/1 to 1/5 in Q12, for the terms of the exp() series
+static const uint16_t breathe_exp_terms[] = {4096, 2048, 1365, 1024, 819};
+#    endif
+
 static uint8_t breathe_calc(uint8_t pos) {
     // http://sean.voisen.org/blog/2011/10/breathing-led-with-arduino/
 #    ifdef RGBLIGHT_EFFECT_BREATHE_TABLE
     return pgm_read_byte(&rgblight_effect_breathe_table[pos / table_scale]);
 #    else
-    return (exp(sin((pos / 255.0) * M_PI)) - RGBLIGHT_EFFECT_BREATHE_CENTER / M_E) * (RGBLIGHT_EFFECT_BREATHE_MAX / (M_E - 1 / M_E));
+    // exp(sin(pos / 255 * pi)) in Q12, with sin16() and the first terms of the
+    // exp() series, which stays within 1% of the floating point curve
+    int16_t  sin_value = sin16(((uint16_t)pos * 257) >> 1);
+    uint32_t x         = sin_value < 0 ? 0 : ((uint32_t)sin_value + 4) >> 3;
+    uint32_t e         = 4096;
+    for (int8_t n = 4; n >= 0; n--) {
+        e = 4096 + ((((x * e) >> 12) * breathe_exp_terms[n]) >> 12);
+    }
+
+    int32_t val = (((int32_t)e - BREATHE_CENTER_Q12) * BREATHE_SCALE_Q8) >> 20;
+    return val < 0 ? 0 : (val > UINT8_MAX ? UINT8_MAX : val);
 #    endif
 }
 
@@ -1226,11 +1262,12 @@ void rgblight_effect_rainbow_mood(animation_status_t *anim) {
 __attribute__((weak)) const uint8_t RGBLED_RAINBOW_SWIRL_INTERVALS[] PROGMEM = {100, 50, 20};
 
 void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
-    uint8_t hue;
-    uint8_t i;
+    uint8_t  hue;
+    uint8_t  i;
+    uint16_t step = RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds;
 
     for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + anim->current_hue);
+        hue = (step * i + anim->current_hue);
         sethsv(hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[i + rgblight_ranges.effect_start_pos]);
     }
     rgblight_set();
@@ -1275,17 +1312,18 @@ void rgblight_effect_snake(animation_status_t *anim) {
 #    ifdef RGBW
         ledp->w = 0;
 #    endif
-        for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
-            k = pos + j * increment;
-            if (k > RGBLED_NUM) {
-                k = k % RGBLED_NUM;
-            }
-            if (k < 0) {
-                k = k + rgblight_ranges.effect_num_leds;
-            }
-            if (i == k) {
-                sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), ledp);
-            }
+    }
+    // Light each segment of the snake directly, fading towards its tail
+    for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
+        k = pos + j * increment;
+        if (k > RGBLED_NUM) {
+            k = k % RGBLED_NUM;
+        }
+        if (k < 0) {
+            k = k + rgblight_ranges.effect_num_leds;
+        }
+        if (k >= 0 && k < rgblight_ranges.effect_num_leds) {
+            sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), (LED_TYPE *)&led[k + rgblight_ranges.effect_start_pos]);
         }
     }
     rgblight_set();
@@ -1336,20 +1374,10 @@ void rgblight_effect_knight(animation_status_t *anim) {
         led[i].w = 0;
 #    endif
     }
-    // Determine which LEDs should be lit up
-    for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
+    // Light up the LEDs between the bounds, the others were cleared above
+    for (i = MAX(low_bound, 0); i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM && i <= high_bound; i++) {
         cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % rgblight_ranges.effect_num_leds + rgblight_ranges.effect_start_pos;
-
-        if (i >= low_bound && i <= high_bound) {
-            sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[cur]);
-        } else {
-            led[cur].r = 0;
-            led[cur].g = 0;
-            led[cur].b = 0;
-#    ifdef RGBW
-            led[cur].w = 0;
-#    endif
-        }
+        sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[cur]);
     }
     rgblight_set();
 
@@ -1370,24 +1398,30 @@ void rgblight_effect_knight(animation_status_t *anim) {
 #endif
 
 #ifdef RGBLIGHT_EFFECT_CHRISTMAS
-#    define CUBED(x) ((x) * (x) * (x))
+// clang-format off
+// hue_green * pos^3 / (pos^3 + (max_pos - pos)^3) for each pos, so the effect
+// doesn't need a 32-bit division per step
+static const uint8_t PROGMEM christmas_hues[] = {
+     0,  0,  0,  0,  0,  0,  1,  1,  3,  4,  7, 10, 15, 20, 27, 34,
+    42, 50, 57, 64, 69, 74, 77, 80, 81, 83, 83, 84, 84, 84, 84, 84,
+    85
+};
+// clang-format on
 
 /**
  * Christmas lights effect, with a smooth animation between red & green.
  */
 void rgblight_effect_christmas(animation_status_t *anim) {
     static int8_t increment = 1;
-    const uint8_t max_pos   = 32;
+    const uint8_t max_pos   = sizeof(christmas_hues) - 1;
     const uint8_t hue_green = 85;
 
-    uint32_t xa;
-    uint8_t  hue, val;
-    uint8_t  i;
+    uint8_t hue, val;
+    uint8_t i;
 
     // The effect works by animating anim->pos from 0 to 32 and back to 0.
     // The pos is used in a cubic bezier formula to ease-in-out between red and green, leaving the interpolated colors visible as short as possible.
-    xa  = CUBED((uint32_t)anim->pos);
-    hue = ((uint32_t)hue_green) * xa / (xa + CUBED((uint32_t)(max_pos - anim->pos)));
+    hue = pgm_read_byte(&christmas_hues[anim->pos]);
     // Additionally, these interpolated colors get shown with a slightly darker value, to make them less prominent than the main colors.
     val = 255 - (3 * (hue < hue_green / 2 ? hue : hue_green - hue) / 2);
 
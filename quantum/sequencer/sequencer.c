@@ -20,21 +20,189 @@
 
 #ifdef MIDI_ENABLE
 #    include "process_midi.h"
+#    include "midi.h"
 #endif
 
 #ifdef MIDI_MOCKED
 #    include "tests/midi_mock.h"
 #endif
 
+// On ChibiOS, a virtual timer plays the steps, however busy the main loop gets
+#if defined(PROTOCOL_CHIBIOS) && defined(MIDI_ENABLE)
+#    define SEQUENCER_VIRTUAL_TIMER
+#    include <ch.h>
+#    include "qmk_midi.h"
+#endif
+
 sequencer_config_t sequencer_config = {
-    false,    // enabled
-    {false},  // steps
-    {0},      // track notes
-    60,       // tempo
-    SQ_RES_4, // resolution
+    false,                    // enabled
+    {false},                  // steps
+    {0},                      // track notes
+    60,                       // tempo
+    SQ_RES_4,                 // resolution
+    50,                       // swing
+    {0},                      // track resolutions
+    SEQUENCER_CLOCK_INTERNAL, // clock source
 };
 
-sequencer_state_t sequencer_internal_state = {0, 0, 0, 0, SEQUENCER_PHASE_ATTACK};
+sequencer_state_t sequencer_internal_state = {0, 0, 0, 0, SEQUENCER_PHASE_ATTACK, {0}};
+
+sequencer_track_state_t sequencer_track_states[SEQUENCER_TRACKS];
+
+// The number of MIDI clock pulses of a step, for each resolution
+static const uint8_t pulses_per_step[SEQUENCER_RESOLUTIONS] = {48, 32, 24, 16, 12, 8, 6, 4, 3};
+
+#ifdef SEQUENCER_MIDI_CLOCK_OUT
+static uint16_t                midi_clock_out_timer;
+static sequencer_clock_state_t midi_clock_out;
+static uint8_t                 midi_clock_out_pending; // pulses due that the MIDI queue had no room for yet
+#endif
+
+static uint16_t midi_clock_beat_timer;
+static uint8_t  midi_clock_beat_pulses;
+static bool     midi_clock_downbeat = false; // the next pulse is the one the host started on
+
+#ifdef SEQUENCER_VIRTUAL_TIMER
+static virtual_timer_t   sequencer_vt;
+static bool              sequencer_vt_initialized = false;
+static volatile uint16_t sequencer_time           = 0; // ms, counted by the virtual timer
+
+// The state machine runs in the virtual timer callback, the main loop only updates it locked
+#    define sequencer_lock() chSysLock()
+#    define sequencer_unlock() chSysUnlock()
+#    define sequencer_timer_read() (sequencer_time)
+#else
+#    define sequencer_lock()
+#    define sequencer_unlock()
+#    define sequencer_timer_read() timer_read()
+#endif
+#define sequencer_timer_elapsed(last) TIMER_DIFF_16(sequencer_timer_read(), last)
+
+#if defined(SEQUENCER_MIDI_CLOCK_OUT) && (defined(MIDI_ENABLE) || defined(MIDI_MOCKED))
+static void sequencer_send_realtime(uint8_t status) {
+    // When following the MIDI clock, the host is the one sending it
+    if (sequencer_config.clock_source == SEQUENCER_CLOCK_INTERNAL) {
+        process_midi_basic_realtime(status);
+    }
+}
+#else
+#    define sequencer_send_realtime(status)
+#endif
+
+/**
+ * Send the note on or off of the `track` from the state machine, which can't wait for room in the MIDI queue
+ * when it runs in the virtual timer callback: returns false if the note has to be sent again on the next tick.
+ */
+static bool sequencer_queue_note(uint8_t track, bool on) {
+#if defined(SEQUENCER_VIRTUAL_TIMER)
+    uint8_t note = midi_compute_note(sequencer_config.track_notes[track]);
+    // Same as process_midi_basic_noteon/noteoff
+    return on ? midi_queue_i(3, MIDI_NOTEON, note, 127) : midi_queue_i(3, MIDI_NOTEOFF, note, 0);
+#elif defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
+    if (on) {
+        process_midi_basic_noteon(midi_compute_note(sequencer_config.track_notes[track]));
+    } else {
+        process_midi_basic_noteoff(midi_compute_note(sequencer_config.track_notes[track]));
+    }
+    return true;
+#else
+    return true;
+#endif
+}
+
+/**
+ * Send the note offs of the `tracks`, a bit each, from the main loop.
+ */
+static void sequencer_release_notes(uint8_t tracks) {
+#if defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        if ((tracks >> track) & true) {
+            process_midi_basic_noteoff(midi_compute_note(sequencer_config.track_notes[track]));
+        }
+    }
+#endif
+}
+
+#ifdef SEQUENCER_VIRTUAL_TIMER
+static void sequencer_step_task(void);
+
+static void sequencer_vt_callback(virtual_timer_t *vtp, void *p) {
+    chSysLockFromISR();
+    sequencer_time++;
+    sequencer_step_task();
+    chSysUnlockFromISR();
+}
+
+static void sequencer_start_timer(void) {
+    if (!sequencer_vt_initialized) {
+        chVTObjectInit(&sequencer_vt);
+        sequencer_vt_initialized = true;
+    }
+    if (!chVTIsArmed(&sequencer_vt)) {
+        // Tick every ms on the system clock, rather than on each pass of the main loop
+        chVTSetContinuous(&sequencer_vt, TIME_MS2I(1), sequencer_vt_callback, NULL);
+    }
+}
+
+static void sequencer_stop_timer(void) {
+    if (sequencer_vt_initialized) {
+        chVTReset(&sequencer_vt);
+    }
+}
+#else
+#    define sequencer_start_timer()
+#    define sequencer_stop_timer()
+#endif
+
+/**
+ * Whether the note of the `track` is on: its attack was sent, and its release wasn't yet.
+ */
+static bool is_sequencer_track_note_held(uint8_t track) {
+    if (has_sequencer_track_own_resolution(track)) {
+        sequencer_track_state_t *state = &sequencer_track_states[track];
+        return state->phase == SEQUENCER_PHASE_RELEASE && is_sequencer_step_on_for_track(state->current_step, track);
+    }
+
+    // The tracks are attacked upwards, up to `current_track` excluded, and released downwards from it
+    switch (sequencer_internal_state.phase) {
+        case SEQUENCER_PHASE_ATTACK:
+            if (track >= sequencer_internal_state.current_track) {
+                return false;
+            }
+            break;
+        case SEQUENCER_PHASE_RELEASE:
+            if (track > sequencer_internal_state.current_track) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return is_sequencer_step_on_for_track(sequencer_internal_state.current_step, track);
+}
+
+/**
+ * Stop playing, and return the tracks whose note still has to be released, a bit each.
+ *
+ * The current step is kept, and resumes from its pause.
+ */
+static uint8_t sequencer_stop_playing(void) {
+    uint8_t held_tracks = 0;
+
+    if (!sequencer_config.enabled) {
+        return held_tracks;
+    }
+
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        if (is_sequencer_track_note_held(track)) {
+            held_tracks |= 1 << track;
+        }
+        sequencer_track_states[track].phase = SEQUENCER_PHASE_PAUSE;
+    }
+    sequencer_internal_state.phase = SEQUENCER_PHASE_PAUSE;
+    sequencer_config.enabled       = false;
+    return held_tracks;
+}
 
 bool is_sequencer_on(void) {
     return sequencer_config.enabled;
@@ -42,17 +210,42 @@ bool is_sequencer_on(void) {
 
 void sequencer_on(void) {
     dprintln("sequencer on");
+    sequencer_lock();
     sequencer_config.enabled               = true;
     sequencer_internal_state.current_track = 0;
     sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.timer         = timer_read();
+    sequencer_internal_state.timer         = sequencer_timer_read();
     sequencer_internal_state.phase         = SEQUENCER_PHASE_ATTACK;
+    sequencer_internal_state.clock         = (sequencer_clock_state_t){0};
+
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        sequencer_track_states[track].current_step = 0;
+        sequencer_track_states[track].timer        = sequencer_internal_state.timer;
+        sequencer_track_states[track].phase        = SEQUENCER_PHASE_ATTACK;
+        sequencer_track_states[track].clock        = (sequencer_clock_state_t){0};
+    }
+
+    midi_clock_beat_timer  = sequencer_internal_state.timer;
+    midi_clock_beat_pulses = 0;
+#ifdef SEQUENCER_MIDI_CLOCK_OUT
+    midi_clock_out_timer   = sequencer_internal_state.timer;
+    midi_clock_out         = (sequencer_clock_state_t){0};
+    midi_clock_out_pending = 0;
+#endif
+    sequencer_unlock();
+    sequencer_send_realtime(MIDI_START);
+    sequencer_start_timer();
 }
 
 void sequencer_off(void) {
     dprintln("sequencer off");
-    sequencer_config.enabled              = false;
+    sequencer_lock();
+    uint8_t held_tracks                   = sequencer_stop_playing();
     sequencer_internal_state.current_step = 0;
+    sequencer_unlock();
+    sequencer_stop_timer();
+    sequencer_release_notes(held_tracks);
+    sequencer_send_realtime(MIDI_STOP);
 }
 
 void sequencer_toggle(void) {
@@ -181,27 +374,243 @@ void sequencer_decrease_resolution(void) {
     sequencer_set_resolution(sequencer_config.resolution - 1);
 }
 
+bool has_sequencer_track_own_resolution(uint8_t track) {
+    return track < SEQUENCER_TRACKS && sequencer_config.track_resolutions[track] > 0;
+}
+
+sequencer_resolution_t sequencer_get_track_resolution(uint8_t track) {
+    if (!has_sequencer_track_own_resolution(track)) {
+        return sequencer_config.resolution;
+    }
+    return sequencer_config.track_resolutions[track] - 1;
+}
+
+/**
+ * Hand the track over between the state machine playing all the tracks and its own sequence of steps,
+ * starting over from the current step of all the tracks.
+ *
+ * @param track_resolution the new `sequencer_config.track_resolutions` value of the track
+ */
+static void sequencer_track_join(uint8_t track, uint8_t track_resolution) {
+    sequencer_lock();
+    // Don't leave behind a note that nothing would release anymore
+    bool held = sequencer_config.enabled && is_sequencer_track_note_held(track);
+
+    sequencer_track_states[track].current_step = sequencer_internal_state.current_step;
+    sequencer_track_states[track].timer        = sequencer_internal_state.timer;
+    sequencer_track_states[track].phase        = SEQUENCER_PHASE_PAUSE;
+    sequencer_track_states[track].clock        = sequencer_internal_state.clock;
+    sequencer_config.track_resolutions[track]  = track_resolution;
+    sequencer_unlock();
+
+    if (held) {
+        sequencer_release_notes(1 << track);
+    }
+}
+
+void sequencer_set_track_resolution(uint8_t track, sequencer_resolution_t resolution) {
+    if (track >= SEQUENCER_TRACKS) {
+        dprintf("sequencer: track %d is out of range\n", track);
+    } else if (resolution >= 0 && resolution < SEQUENCER_RESOLUTIONS) {
+        sequencer_track_join(track, resolution + 1);
+        dprintf("sequencer: track %d resolution set to %d\n", track, resolution);
+    } else {
+        dprintf("sequencer: resolution %d is out of range\n", resolution);
+    }
+}
+
+void sequencer_reset_track_resolution(uint8_t track) {
+    if (has_sequencer_track_own_resolution(track)) {
+        sequencer_track_join(track, 0);
+        dprintf("sequencer: track %d follows the resolution\n", track);
+    }
+}
+
+uint8_t sequencer_get_swing(void) {
+    return sequencer_config.swing;
+}
+
+void sequencer_set_swing(uint8_t swing) {
+    if (swing >= 50 && swing <= SEQUENCER_SWING_MAX) {
+        sequencer_config.swing = swing;
+        dprintf("sequencer: swing set to %d%%\n", swing);
+    } else {
+        dprintf("sequencer: swing %d%% is out of range\n", swing);
+    }
+}
+
+sequencer_clock_source_t sequencer_get_clock_source(void) {
+    return sequencer_config.clock_source;
+}
+
+void sequencer_set_clock_source(sequencer_clock_source_t source) {
+    sequencer_config.clock_source = source;
+    dprintf("sequencer: clock source set to %d\n", source);
+}
+
 uint8_t sequencer_get_current_step(void) {
     return sequencer_internal_state.current_step;
 }
 
-void sequencer_phase_attack(void) {
-    dprintf("sequencer: step %d\n", sequencer_internal_state.current_step);
-    dprintf("sequencer: time %d\n", timer_read());
+/**
+ * Duration of `pulses` MIDI clock pulses at the current tempo, scaled by `share` / 50, in ms.
+ *
+ * The fraction of a ms left over is returned in `remainder`, and is added in by the next call.
+ */
+static uint16_t pulses_duration(uint8_t pulses, uint8_t share, uint32_t *remainder) {
+    uint8_t tempo = sequencer_config.tempo > 0 ? sequencer_config.tempo : 60;
+
+    // One pulse lasts 60000ms / (tempo * 24) = 2500ms / tempo
+    uint32_t denominator = (uint32_t)tempo * 50;
+    uint32_t numerator   = 2500UL * pulses * share + *remainder;
+    uint32_t duration    = numerator / denominator;
 
-    if (sequencer_internal_state.current_track == 0) {
-        sequencer_internal_state.timer = timer_read();
+    *remainder = numerator % denominator;
+    return duration < UINT16_MAX ? duration : UINT16_MAX;
+}
+
+/**
+ * The swing makes the first step of each pair longer, and the second one shorter by as much.
+ */
+static uint8_t step_share(uint8_t step) {
+    return step % 2 == 0 ? sequencer_config.swing : 100 - sequencer_config.swing;
+}
+
+/**
+ * Whether the step lasting `pulses` that started at `timer` is over; if it is, `timer` moves on
+ * to the exact time the next step started, however late the main loop got here.
+ */
+static bool sequencer_clock_next_step_due(uint16_t *timer, sequencer_clock_state_t *clock, uint8_t pulses, uint8_t share) {
+    if (sequencer_config.clock_source == SEQUENCER_CLOCK_MIDI) {
+        if (!clock->pending) {
+            return false;
+        }
+
+        // The MIDI clock only marks straight steps, the second step of each pair is delayed from there
+        uint32_t remainder = 0;
+        uint16_t delay     = share > 50 ? pulses_duration(pulses, share - 50, &remainder) : 0;
+        if (sequencer_timer_elapsed(clock->boundary) < delay) {
+            return false;
+        }
+
+        *timer         = clock->boundary + delay;
+        clock->pending = false;
+        return true;
     }
 
-    if (timer_elapsed(sequencer_internal_state.timer) < sequencer_internal_state.current_track * SEQUENCER_TRACK_THROTTLE) {
+    uint32_t remainder = clock->remainder;
+    uint16_t duration  = pulses_duration(pulses, share, &remainder);
+    uint16_t elapsed   = sequencer_timer_elapsed(*timer);
+
+    if (elapsed < duration) {
+        return false;
+    }
+
+    if (elapsed - duration >= duration) {
+        // More than a whole step late: start over from now, rather than rush through the missed steps
+        *timer           = sequencer_timer_read();
+        clock->remainder = 0;
+    } else {
+        *timer += duration;
+        clock->remainder = remainder;
+    }
+    return true;
+}
+
+static void sequencer_clock_pulse(sequencer_clock_state_t *clock, sequencer_resolution_t resolution) {
+    if (++clock->pulses >= pulses_per_step[resolution]) {
+        clock->pulses   = 0;
+        clock->boundary = sequencer_timer_read();
+        clock->pending  = true;
+    }
+}
+
+#if defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
+static void sequencer_midi_clock_pulse(void) {
+    if (!sequencer_config.enabled) {
         return;
     }
 
+    if (midi_clock_downbeat) {
+        // The first step was played when the host started, this pulse only marks when
+        midi_clock_downbeat    = false;
+        midi_clock_beat_timer  = sequencer_timer_read();
+        midi_clock_beat_pulses = 0;
+        return;
+    }
+
+    // Follow the tempo of the host, which the swing is measured in
+    if (++midi_clock_beat_pulses == SEQUENCER_PPQN) {
+        uint16_t beat          = sequencer_timer_elapsed(midi_clock_beat_timer);
+        midi_clock_beat_timer  = sequencer_timer_read();
+        midi_clock_beat_pulses = 0;
+        if (beat >= 60000 / UINT8_MAX) {
+            sequencer_config.tempo = (60000 + beat / 2) / beat;
+        }
+    }
+
+    sequencer_clock_pulse(&sequencer_internal_state.clock, sequencer_config.resolution);
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        if (has_sequencer_track_own_resolution(track)) {
+            sequencer_clock_pulse(&sequencer_track_states[track].clock, sequencer_get_track_resolution(track));
+        }
+    }
+}
+
+#endif
+
+void sequencer_process_midi_realtime(uint8_t status) {
 #if defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
-    if (is_sequencer_step_on_for_track(sequencer_internal_state.current_step, sequencer_internal_state.current_track)) {
-        process_midi_basic_noteon(midi_compute_note(sequencer_config.track_notes[sequencer_internal_state.current_track]));
+    if (sequencer_config.clock_source != SEQUENCER_CLOCK_MIDI) {
+        return;
+    }
+
+    switch (status) {
+        case MIDI_START:
+            sequencer_on();
+            midi_clock_downbeat = true;
+            break;
+        case MIDI_CONTINUE:
+            dprintln("sequencer: continue");
+            sequencer_config.enabled = true;
+            sequencer_start_timer();
+            break;
+        case MIDI_STOP: {
+            // Unlike `sequencer_off`, keep the current step for the host to continue from
+            dprintln("sequencer: stop");
+            sequencer_lock();
+            uint8_t held_tracks = sequencer_stop_playing();
+            sequencer_unlock();
+            sequencer_stop_timer();
+            sequencer_release_notes(held_tracks);
+            break;
+        }
+        case MIDI_CLOCK:
+            sequencer_lock();
+            sequencer_midi_clock_pulse();
+            sequencer_unlock();
+            break;
     }
 #endif
+}
+
+static bool is_sequencer_step_on_for_shared_track(uint8_t step, uint8_t track) {
+    return !has_sequencer_track_own_resolution(track) && is_sequencer_step_on_for_track(step, track);
+}
+
+void sequencer_phase_attack(void) {
+#ifndef SEQUENCER_VIRTUAL_TIMER // nothing may print from the timer callback
+    dprintf("sequencer: step %d\n", sequencer_internal_state.current_step);
+    dprintf("sequencer: time %d\n", timer_read());
+#endif
+
+    if (sequencer_timer_elapsed(sequencer_internal_state.timer) < sequencer_internal_state.current_track * SEQUENCER_TRACK_THROTTLE) {
+        return;
+    }
+
+    if (is_sequencer_step_on_for_shared_track(sequencer_internal_state.current_step, sequencer_internal_state.current_track) && !sequencer_queue_note(sequencer_internal_state.current_track, true)) {
+        return;
+    }
 
     if (sequencer_internal_state.current_track < SEQUENCER_TRACKS - 1) {
         sequencer_internal_state.current_track++;
@@ -211,14 +620,12 @@ void sequencer_phase_attack(void) {
 }
 
 void sequencer_phase_release(void) {
-    if (timer_elapsed(sequencer_internal_state.timer) < SEQUENCER_PHASE_RELEASE_TIMEOUT + sequencer_internal_state.current_track * SEQUENCER_TRACK_THROTTLE) {
+    if (sequencer_timer_elapsed(sequencer_internal_state.timer) < SEQUENCER_PHASE_RELEASE_TIMEOUT + sequencer_internal_state.current_track * SEQUENCER_TRACK_THROTTLE) {
         return;
     }
-#if defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
-    if (is_sequencer_step_on_for_track(sequencer_internal_state.current_step, sequencer_internal_state.current_track)) {
-        process_midi_basic_noteoff(midi_compute_note(sequencer_config.track_notes[sequencer_internal_state.current_track]));
+    if (is_sequencer_step_on_for_shared_track(sequencer_internal_state.current_step, sequencer_internal_state.current_track) && !sequencer_queue_note(sequencer_internal_state.current_track, false)) {
+        return;
     }
-#endif
     if (sequencer_internal_state.current_track > 0) {
         sequencer_internal_state.current_track--;
     } else {
@@ -227,7 +634,8 @@ void sequencer_phase_release(void) {
 }
 
 void sequencer_phase_pause(void) {
-    if (timer_elapsed(sequencer_internal_state.timer) < sequencer_get_step_duration()) {
+    uint8_t pulses = pulses_per_step[sequencer_config.resolution];
+    if (!sequencer_clock_next_step_due(&sequencer_internal_state.timer, &sequencer_internal_state.clock, pulses, step_share(sequencer_internal_state.current_step))) {
         return;
     }
 
@@ -235,11 +643,79 @@ void sequencer_phase_pause(void) {
     sequencer_internal_state.phase        = SEQUENCER_PHASE_ATTACK;
 }
 
-void sequencer_task(void) {
+/**
+ * Play a track with a resolution of its own, going through the same phases as the other tracks.
+ */
+static void sequencer_track_task(uint8_t track) {
+    sequencer_track_state_t *state = &sequencer_track_states[track];
+
+    if (state->phase == SEQUENCER_PHASE_PAUSE) {
+        uint8_t pulses = pulses_per_step[sequencer_get_track_resolution(track)];
+        if (sequencer_clock_next_step_due(&state->timer, &state->clock, pulses, step_share(state->current_step))) {
+            state->current_step = (state->current_step + 1) % SEQUENCER_STEPS;
+            state->phase        = SEQUENCER_PHASE_ATTACK;
+        }
+    }
+
+    if (state->phase == SEQUENCER_PHASE_RELEASE) {
+        if (sequencer_timer_elapsed(state->timer) < SEQUENCER_PHASE_RELEASE_TIMEOUT + track * SEQUENCER_TRACK_THROTTLE) {
+            return;
+        }
+        if (is_sequencer_step_on_for_track(state->current_step, track) && !sequencer_queue_note(track, false)) {
+            return;
+        }
+        state->phase = SEQUENCER_PHASE_PAUSE;
+    }
+
+    if (state->phase == SEQUENCER_PHASE_ATTACK) {
+        if (sequencer_timer_elapsed(state->timer) < track * SEQUENCER_TRACK_THROTTLE) {
+            return;
+        }
+        if (is_sequencer_step_on_for_track(state->current_step, track) && !sequencer_queue_note(track, true)) {
+            return;
+        }
+        state->phase = SEQUENCER_PHASE_RELEASE;
+    }
+}
+
+#ifdef SEQUENCER_MIDI_CLOCK_OUT
+/**
+ * Send a realtime message from the state machine, see `sequencer_queue_note`.
+ */
+static bool sequencer_queue_realtime(uint8_t status) {
+#ifdef SEQUENCER_VIRTUAL_TIMER
+    return midi_queue_i(1, status, 0, 0);
+#else
+    sequencer_send_realtime(status);
+    return true;
+#endif
+}
+
+static void sequencer_midi_clock_out_task(void) {
+    if (sequencer_config.clock_source != SEQUENCER_CLOCK_INTERNAL) {
+        return;
+    }
+    if (sequencer_clock_next_step_due(&midi_clock_out_timer, &midi_clock_out, 1, 50)) {
+        midi_clock_out_pending++;
+    }
+    if (midi_clock_out_pending && sequencer_queue_realtime(MIDI_CLOCK)) {
+        midi_clock_out_pending--;
+    }
+}
+#endif
+
+/**
+ * Play the steps: from the virtual timer callback on ChibiOS, from the main loop otherwise.
+ */
+static void sequencer_step_task(void) {
     if (!sequencer_config.enabled) {
         return;
     }
 
+#ifdef SEQUENCER_MIDI_CLOCK_OUT
+    sequencer_midi_clock_out_task();
+#endif
+
     if (sequencer_internal_state.phase == SEQUENCER_PHASE_PAUSE) {
         sequencer_phase_pause();
     }
@@ -251,6 +727,18 @@ void sequencer_task(void) {
     if (sequencer_internal_state.phase == SEQUENCER_PHASE_ATTACK) {
         sequencer_phase_attack();
     }
+
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        if (has_sequencer_track_own_resolution(track)) {
+            sequencer_track_task(track);
+        }
+    }
+}
+
+void sequencer_task(void) {
+#ifndef SEQUENCER_VIRTUAL_TIMER
+    sequencer_step_task();
+#endif
 }
 
 uint16_t sequencer_get_beat_duration(void) {
@@ -37,6 +37,14 @@
 #    define SEQUENCER_PHASE_RELEASE_TIMEOUT 30
 #endif
 
+// Swing, in percent of a pair of steps given to the first one: 50 plays straight
+#ifndef SEQUENCER_SWING_MAX
+#    define SEQUENCER_SWING_MAX 75
+#endif
+
+// The sequencer keeps time in MIDI clock pulses: 24 per beat
+#define SEQUENCER_PPQN 24
+
 /**
  * Make sure that the items of this enumeration follow the powers of 2, separated by a ternary variant.
  * Check the implementation of `get_step_duration` for further explanation.
@@ -54,12 +62,20 @@ typedef enum {
     SEQUENCER_RESOLUTIONS
 } sequencer_resolution_t;
 
+typedef enum {
+    SEQUENCER_CLOCK_INTERNAL, // steps follow the tempo, measured with the system timer
+    SEQUENCER_CLOCK_MIDI,     // steps follow the MIDI clock messages received from the host
+} sequencer_clock_source_t;
+
 typedef struct {
-    bool                   enabled;
-    uint8_t                steps[SEQUENCER_STEPS];
-    uint16_t               track_notes[SEQUENCER_TRACKS];
-    uint8_t                tempo; // Is a maximum tempo of 255 reasonable?
-    sequencer_resolution_t resolution;
+    bool                     enabled;
+    uint8_t                  steps[SEQUENCER_STEPS];
+    uint16_t                 track_notes[SEQUENCER_TRACKS];
+    uint8_t                  tempo; // Is a maximum tempo of 255 reasonable?
+    sequencer_resolution_t   resolution;
+    uint8_t                  swing;
+    uint8_t                  track_resolutions[SEQUENCER_TRACKS]; // 0 follows `resolution`, otherwise the track resolution + 1
+    sequencer_clock_source_t clock_source;
 } sequencer_config_t;
 
 /**
@@ -72,18 +88,45 @@ typedef enum sequencer_phase_t {
     SEQUENCER_PHASE_PAUSE    // t=step duration ms, loop
 } sequencer_phase_t;
 
+/**
+ * Where a sequence of steps is at between two steps.
+ *
+ * Step durations are rarely a whole number of milliseconds, so the fraction left over by each
+ * step is carried over to the next one: the steps never drift away from the tempo, however long
+ * the sequence plays and however late the main loop gets to them.
+ */
+typedef struct {
+    uint32_t remainder; // fraction of a millisecond the step timer is ahead of the exact time
+    uint16_t boundary;  // MIDI clock: when the pulse that ended the last step was received
+    uint8_t  pulses;    // MIDI clock: pulses received since the last step boundary
+    bool     pending;   // MIDI clock: the step boundary has not been played yet
+} sequencer_clock_state_t;
+
 typedef struct {
-    uint8_t           active_tracks;
-    uint8_t           current_track;
-    uint8_t           current_step;
-    uint16_t          timer;
-    sequencer_phase_t phase;
+    uint8_t                 active_tracks;
+    uint8_t                 current_track;
+    uint8_t                 current_step;
+    uint16_t                timer; // when the current step started
+    sequencer_phase_t       phase;
+    sequencer_clock_state_t clock;
 } sequencer_state_t;
 
+/**
+ * Tracks with a resolution of their own are played on their own sequence of steps, next to the
+ * state machine that plays all the other tracks.
+ */
+typedef struct {
+    uint8_t                 current_step;
+    uint16_t                timer;
+    sequencer_phase_t       phase;
+    sequencer_clock_state_t clock;
+} sequencer_track_state_t;
+
 extern sequencer_config_t sequencer_config;
 
 // We expose the internal state to make the feature more "unit-testable"
-extern sequencer_state_t sequencer_internal_state;
+extern sequencer_state_t       sequencer_internal_state;
+extern sequencer_track_state_t sequencer_track_states[SEQUENCER_TRACKS];
 
 bool is_sequencer_on(void);
 void sequencer_toggle(void);
@@ -121,6 +164,23 @@ void                   sequencer_set_resolution(sequencer_resolution_t resolutio
 void                   sequencer_increase_resolution(void);
 void                   sequencer_decrease_resolution(void);
 
+sequencer_resolution_t sequencer_get_track_resolution(uint8_t track);
+void                   sequencer_set_track_resolution(uint8_t track, sequencer_resolution_t resolution);
+void                   sequencer_reset_track_resolution(uint8_t track);
+bool                   has_sequencer_track_own_resolution(uint8_t track);
+
+uint8_t sequencer_get_swing(void);
+void    sequencer_set_swing(uint8_t swing);
+
+sequencer_clock_source_t sequencer_get_clock_source(void);
+void                     sequencer_set_clock_source(sequencer_clock_source_t source);
+
+/**
+ * Feed a MIDI realtime message received from the host to the sequencer: when it follows the MIDI
+ * clock, clock pulses advance the steps, and start, continue and stop control the playback.
+ */
+void sequencer_process_midi_realtime(uint8_t status);
+
 uint8_t sequencer_get_current_step(void);
 
 uint16_t sequencer_get_beat_duration(void);
@@ -16,8 +16,11 @@
 
 #include "midi_mock.h"
 
-uint16_t last_noteon  = 0;
-uint16_t last_noteoff = 0;
+uint16_t last_noteon      = 0;
+uint16_t last_noteoff     = 0;
+uint8_t  last_realtime    = 0;
+uint16_t midi_clock_count = 0;
+uint8_t  noteoff_count    = 0;
 
 uint16_t midi_compute_note(uint16_t keycode) {
     return keycode;
@@ -29,4 +32,12 @@ void process_midi_basic_noteon(uint16_t note) {
 
 void process_midi_basic_noteoff(uint16_t note) {
     last_noteoff = note;
+    noteoff_count++;
+}
+
+void process_midi_basic_realtime(uint8_t status) {
+    last_realtime = status;
+    if (status == MIDI_CLOCK) {
+        midi_clock_count++;
+    }
 }
@@ -18,9 +18,18 @@
 
 #include <stdint.h>
 
+#define MIDI_CLOCK 0xF8
+#define MIDI_START 0xFA
+#define MIDI_CONTINUE 0xFB
+#define MIDI_STOP 0xFC
+
 extern uint16_t last_noteon;
 extern uint16_t last_noteoff;
+extern uint8_t  last_realtime;
+extern uint16_t midi_clock_count;
+extern uint8_t  noteoff_count;
 
 uint16_t midi_compute_note(uint16_t keycode);
 void     process_midi_basic_noteon(uint16_t note);
 void     process_midi_basic_noteoff(uint16_t note);
+void     process_midi_basic_realtime(uint8_t status);
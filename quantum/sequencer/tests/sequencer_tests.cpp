@@ -40,16 +40,27 @@ class SequencerTest : public ::testing::Test {
             config_copy.track_notes[i] = sequencer_config.track_notes[i];
         }
 
-        config_copy.tempo      = sequencer_config.tempo;
-        config_copy.resolution = sequencer_config.resolution;
+        for (int i = 0; i < SEQUENCER_TRACKS; i++) {
+            config_copy.track_resolutions[i] = sequencer_config.track_resolutions[i];
+        }
+
+        config_copy.tempo        = sequencer_config.tempo;
+        config_copy.resolution   = sequencer_config.resolution;
+        config_copy.swing        = sequencer_config.swing;
+        config_copy.clock_source = sequencer_config.clock_source;
 
         state_copy.active_tracks = sequencer_internal_state.active_tracks;
         state_copy.current_track = sequencer_internal_state.current_track;
         state_copy.current_step  = sequencer_internal_state.current_step;
         state_copy.timer         = sequencer_internal_state.timer;
+        state_copy.phase         = sequencer_internal_state.phase;
+        state_copy.clock         = sequencer_internal_state.clock;
 
-        last_noteon  = 0;
-        last_noteoff = 0;
+        last_noteon      = 0;
+        last_noteoff     = 0;
+        last_realtime    = 0;
+        midi_clock_count = 0;
+        noteoff_count    = 0;
 
         set_time(0);
     }
@@ -65,13 +76,21 @@ class SequencerTest : public ::testing::Test {
             sequencer_config.track_notes[i] = config_copy.track_notes[i];
         }
 
-        sequencer_config.tempo      = config_copy.tempo;
-        sequencer_config.resolution = config_copy.resolution;
+        for (int i = 0; i < SEQUENCER_TRACKS; i++) {
+            sequencer_config.track_resolutions[i] = config_copy.track_resolutions[i];
+        }
+
+        sequencer_config.tempo        = config_copy.tempo;
+        sequencer_config.resolution   = config_copy.resolution;
+        sequencer_config.swing        = config_copy.swing;
+        sequencer_config.clock_source = config_copy.clock_source;
 
         sequencer_internal_state.active_tracks = state_copy.active_tracks;
         sequencer_internal_state.current_track = state_copy.current_track;
         sequencer_internal_state.current_step  = state_copy.current_step;
         sequencer_internal_state.timer         = state_copy.timer;
+        sequencer_internal_state.phase         = state_copy.phase;
+        sequencer_internal_state.clock         = state_copy.clock;
     }
 
     sequencer_config_t config_copy;
@@ -590,3 +609,289 @@ TEST_F(SequencerTest, TestMatrixScanSequencerShouldLoopOnceSequenceIsOver) {
     EXPECT_EQ(sequencer_internal_state.current_track, 1);
     EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_ATTACK);
 }
+
+/**
+ * Run the main loop for `duration` ms, calling the sequencer every `interval` ms, and return when
+ * the step after `step` started playing - or 0 if it didn't.
+ */
+uint32_t runMainLoopUntilNextStep(uint8_t step, uint32_t now, uint32_t duration, const uint32_t *intervals, int interval_count) {
+    for (int i = 0; now < duration; i++) {
+        now += intervals[i % interval_count];
+        set_time(now);
+        sequencer_task();
+        if (sequencer_get_current_step() != step) {
+            return now;
+        }
+    }
+    return 0;
+}
+
+TEST_F(SequencerTest, TestStepsDoNotDriftAwayFromTheTempo) {
+    const uint32_t every_ms[] = {1};
+
+    setUpMatrixScanSequencerTest();
+    // One 16th at tempo=137 lasts 109.489ms
+    sequencer_config.tempo = 137;
+    sequencer_on();
+
+    uint32_t now = 0;
+    for (uint32_t step = 1; step <= 4 * SEQUENCER_STEPS; step++) {
+        uint32_t exact = step * 6 * 2500 / 137;
+
+        now = runMainLoopUntilNextStep((step - 1) % SEQUENCER_STEPS, now, 10000, every_ms, 1);
+        EXPECT_EQ(sequencer_internal_state.timer, exact);
+        EXPECT_LE(now - exact, 1);
+    }
+}
+
+TEST_F(SequencerTest, TestStepsKeepTheirTimingUnderMainLoopLatency) {
+    // A main loop busy with e.g. RGB effects, taking up to 9ms per iteration
+    const uint32_t intervals[] = {2, 7, 4, 9, 3};
+
+    setUpMatrixScanSequencerTest();
+    sequencer_on();
+
+    uint32_t now = 0;
+    for (uint32_t step = 1; step <= 4 * SEQUENCER_STEPS; step++) {
+        uint32_t exact = step * 125;
+
+        now = runMainLoopUntilNextStep((step - 1) % SEQUENCER_STEPS, now, 10000, intervals, 5);
+        // Each step is only late by the latency of the loop, which doesn't add up from one step to the next
+        EXPECT_EQ(sequencer_internal_state.timer, exact);
+        EXPECT_GE(now, exact);
+        EXPECT_LE(now - exact, 9);
+    }
+}
+
+TEST_F(SequencerTest, TestStartsOverWhenMoreThanAStepLate) {
+    setUpMatrixScanSequencerTest();
+    sequencer_on();
+
+    sequencer_internal_state.phase = SEQUENCER_PHASE_PAUSE;
+    set_time(1000);
+    sequencer_task();
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
+    EXPECT_EQ(sequencer_internal_state.timer, 1000);
+
+    // The missed steps are not rushed through
+    sequencer_internal_state.phase = SEQUENCER_PHASE_PAUSE;
+    advance_time(1);
+    sequencer_task();
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
+}
+
+TEST_F(SequencerTest, TestSetSwing) {
+    sequencer_set_swing(66);
+    EXPECT_EQ(sequencer_get_swing(), 66);
+
+    sequencer_set_swing(SEQUENCER_SWING_MAX + 1);
+    EXPECT_EQ(sequencer_get_swing(), 66);
+
+    sequencer_set_swing(49);
+    EXPECT_EQ(sequencer_get_swing(), 66);
+}
+
+TEST_F(SequencerTest, TestSwingDelaysEverySecondStep) {
+    const uint32_t every_ms[] = {1};
+
+    setUpMatrixScanSequencerTest();
+    sequencer_set_swing(66);
+    sequencer_on();
+
+    // A pair of 16ths at tempo=120 lasts 250ms, 66% of which go to the first one
+    EXPECT_EQ(runMainLoopUntilNextStep(0, 0, 1000, every_ms, 1), 165);
+    EXPECT_EQ(runMainLoopUntilNextStep(1, 165, 1000, every_ms, 1), 250);
+    EXPECT_EQ(runMainLoopUntilNextStep(2, 250, 1000, every_ms, 1), 415);
+    EXPECT_EQ(runMainLoopUntilNextStep(3, 415, 1000, every_ms, 1), 500);
+}
+
+TEST_F(SequencerTest, TestSetTrackResolution) {
+    sequencer_config.resolution = SQ_RES_16;
+
+    EXPECT_EQ(has_sequencer_track_own_resolution(2), false);
+    EXPECT_EQ(sequencer_get_track_resolution(2), SQ_RES_16);
+
+    sequencer_set_track_resolution(2, SQ_RES_8T);
+    EXPECT_EQ(has_sequencer_track_own_resolution(2), true);
+    EXPECT_EQ(sequencer_get_track_resolution(2), SQ_RES_8T);
+    EXPECT_EQ(sequencer_get_track_resolution(1), SQ_RES_16);
+
+    sequencer_reset_track_resolution(2);
+    EXPECT_EQ(has_sequencer_track_own_resolution(2), false);
+    EXPECT_EQ(sequencer_get_track_resolution(2), SQ_RES_16);
+}
+
+TEST_F(SequencerTest, TestTrackWithItsOwnResolution) {
+    setUpMatrixScanSequencerTest();
+    sequencer_config.steps[0] = 0;
+    sequencer_config.steps[1] = (1 << 2);
+    sequencer_config.steps[2] = 0;
+    sequencer_set_track_resolution(2, SQ_RES_8);
+    sequencer_on();
+
+    // The second step of the other tracks doesn't play the track
+    for (uint32_t now = 1; now < 250; now++) {
+        set_time(now);
+        sequencer_task();
+    }
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
+    EXPECT_EQ(last_noteon, 0);
+
+    // Its own second step, an 8th at tempo=120 later, does
+    for (uint32_t now = 250; now <= 250 + 2 * SEQUENCER_TRACK_THROTTLE; now++) {
+        set_time(now);
+        sequencer_task();
+    }
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
+    EXPECT_EQ(sequencer_track_states[2].current_step, 1);
+    EXPECT_EQ(last_noteon, QK_MIDI_NOTE_E_0);
+
+    for (uint32_t now = 257; now <= 250 + SEQUENCER_PHASE_RELEASE_TIMEOUT + 2 * SEQUENCER_TRACK_THROTTLE; now++) {
+        set_time(now);
+        sequencer_task();
+    }
+    EXPECT_EQ(last_noteoff, QK_MIDI_NOTE_E_0);
+}
+
+TEST_F(SequencerTest, TestSendsMidiClock) {
+    setUpMatrixScanSequencerTest();
+
+    sequencer_on();
+    EXPECT_EQ(last_realtime, MIDI_START);
+
+    // One pulse at tempo=120 lasts 20.833ms
+    for (uint32_t now = 1; now <= 1000; now++) {
+        set_time(now);
+        sequencer_task();
+    }
+    EXPECT_EQ(midi_clock_count, 48);
+
+    sequencer_off();
+    EXPECT_EQ(last_realtime, MIDI_STOP);
+}
+
+TEST_F(SequencerTest, TestIgnoresMidiClockWithInternalClock) {
+    setUpMatrixScanSequencerTest();
+
+    sequencer_process_midi_realtime(MIDI_STOP);
+    EXPECT_EQ(is_sequencer_on(), true);
+}
+
+/**
+ * Send MIDI clock pulses every `interval` ms, calling the sequencer every ms in between.
+ */
+void sendMidiClock(uint32_t from, uint32_t to, uint32_t interval) {
+    for (uint32_t now = from; now <= to; now++) {
+        set_time(now);
+        if ((now - from) % interval == 0) {
+            sequencer_process_midi_realtime(MIDI_CLOCK);
+        }
+        sequencer_task();
+    }
+}
+
+TEST_F(SequencerTest, TestFollowsMidiClock) {
+    setUpMatrixScanSequencerTest();
+    sequencer_config.enabled = false;
+    sequencer_set_clock_source(SEQUENCER_CLOCK_MIDI);
+
+    sequencer_process_midi_realtime(MIDI_START);
+    EXPECT_EQ(is_sequencer_on(), true);
+    // The host sends the clock itself
+    EXPECT_EQ(last_realtime, 0);
+
+    // A pulse every 20ms is a tempo of 125, where a 16th lasts 6 pulses
+    sendMidiClock(0, 119, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 0);
+    sendMidiClock(120, 120, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
+    EXPECT_EQ(sequencer_internal_state.timer, 120);
+
+    // The tempo follows the host, once a whole beat has been received
+    sendMidiClock(140, 480, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 4);
+    EXPECT_EQ(sequencer_get_tempo(), 125);
+
+    // Without pulses, the sequencer waits for the host
+    for (uint32_t now = 481; now < 1000; now++) {
+        set_time(now);
+        sequencer_task();
+    }
+    EXPECT_EQ(sequencer_internal_state.current_step, 4);
+    EXPECT_EQ(midi_clock_count, 0);
+}
+
+TEST_F(SequencerTest, TestSwingFollowsMidiClock) {
+    setUpMatrixScanSequencerTest();
+    sequencer_config.tempo = 125;
+    sequencer_set_swing(66);
+    sequencer_set_clock_source(SEQUENCER_CLOCK_MIDI);
+
+    sequencer_process_midi_realtime(MIDI_START);
+    sendMidiClock(0, 120, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 0);
+
+    // A 16th at tempo=125 lasts 120ms, the swing delays the second one by 16% of a pair
+    for (uint32_t now = 121; now <= 158; now++) {
+        set_time(now);
+        sequencer_task();
+    }
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
+    EXPECT_EQ(sequencer_internal_state.timer, 158);
+
+    // The third step is back on the beat
+    sendMidiClock(140, 240, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
+    EXPECT_EQ(sequencer_internal_state.timer, 240);
+}
+
+TEST_F(SequencerTest, TestMidiStopAndContinue) {
+    setUpMatrixScanSequencerTest();
+    sequencer_set_clock_source(SEQUENCER_CLOCK_MIDI);
+
+    sequencer_process_midi_realtime(MIDI_START);
+    sendMidiClock(0, 240, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
+
+    sequencer_process_midi_realtime(MIDI_STOP);
+    EXPECT_EQ(is_sequencer_on(), false);
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
+
+    sequencer_process_midi_realtime(MIDI_CONTINUE);
+    EXPECT_EQ(is_sequencer_on(), true);
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
+}
+
+TEST_F(SequencerTest, TestMidiStopReleasesHeldNotes) {
+    setUpMatrixScanSequencerTest();
+    sequencer_set_clock_source(SEQUENCER_CLOCK_MIDI);
+
+    // The third step plays the first two tracks
+    sequencer_process_midi_realtime(MIDI_START);
+    sendMidiClock(0, 240 + SEQUENCER_TRACK_THROTTLE, 20);
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
+    EXPECT_EQ(last_noteon, QK_MIDI_NOTE_D_0);
+    EXPECT_EQ(noteoff_count, 1);
+
+    sequencer_process_midi_realtime(MIDI_STOP);
+    EXPECT_EQ(is_sequencer_on(), false);
+    EXPECT_EQ(noteoff_count, 3);
+    EXPECT_EQ(last_noteoff, QK_MIDI_NOTE_D_0);
+
+    // Nothing is left to release when the host continues
+    sequencer_process_midi_realtime(MIDI_CONTINUE);
+    sendMidiClock(244, 359, 20);
+    EXPECT_EQ(noteoff_count, 3);
+}
+
+TEST_F(SequencerTest, TestOffReleasesHeldNotes) {
+    setUpMatrixScanSequencerTest();
+    sequencer_on();
+
+    sequencer_task();
+    EXPECT_EQ(last_noteon, QK_MIDI_NOTE_C_0);
+
+    sequencer_off();
+    EXPECT_EQ(noteoff_count, 1);
+    EXPECT_EQ(last_noteoff, QK_MIDI_NOTE_C_0);
+}
@@ -27,6 +27,11 @@
 #    include "eeconfig.h"
 #endif
 
+#ifdef SPLIT_EXTRA_NODES
+#    include <string.h>
+#    include "transactions.h"
+#endif
+
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLED_SPLIT)
 #    include "rgblight.h"
 #endif
@@ -132,7 +137,10 @@ static uint8_t peek_matrix_intersection(pin_t out_pin, pin_t in_pin) {
 #endif
 
 __attribute__((weak)) bool is_keyboard_left(void) {
-#if defined(SPLIT_HAND_PIN)
+#if defined(SPLIT_NODE_ID)
+    // Extra nodes have their own pin configuration
+    return true;
+#elif defined(SPLIT_HAND_PIN)
     // Test pin SPLIT_HAND_PIN for High/Low, if low it's right hand
 #    ifdef SPLIT_HAND_PIN_LOW_IS_LEFT
     return !readPin(SPLIT_HAND_PIN);
@@ -155,6 +163,10 @@ __attribute__((weak)) bool is_keyboard_left(void) {
 }
 
 __attribute__((weak)) bool is_keyboard_master(void) {
+#if defined(SPLIT_NODE_ID)
+    // Extra nodes are always polled by the master half
+    return false;
+#else
     static enum { UNKNOWN, MASTER, SLAVE } usbstate = UNKNOWN;
 
     // only check once, as this is called often
@@ -168,6 +180,7 @@ __attribute__((weak)) bool is_keyboard_master(void) {
     }
 
     return (usbstate == MASTER);
+#endif
 }
 
 // this code runs before the keyboard is fully initialized
@@ -262,3 +275,74 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
 #endif // SPLIT_MAX_CONNECTION_ERRORS > 0
     return true;
 }
+
+#ifdef SPLIT_EXTRA_NODES
+// Max number of extra nodes polled per scan cycle, the others are polled on the following scans.
+// This keeps the scan rate independent of the number of nodes, at the cost of each node's latency.
+#    ifndef SPLIT_NODES_PER_SCAN
+#        define SPLIT_NODES_PER_SCAN 1
+#    endif // SPLIT_NODES_PER_SCAN
+
+typedef struct _split_node_state_t {
+    uint8_t  connection_errors;
+    uint16_t connection_check_timer;
+} split_node_state_t;
+
+static split_node_state_t node_states[SPLIT_EXTRA_NODES];
+
+bool is_node_connected(uint8_t node) {
+#    if SPLIT_MAX_CONNECTION_ERRORS > 0
+    return node_states[node].connection_errors < SPLIT_MAX_CONNECTION_ERRORS;
+#    else
+    return true;
+#    endif // SPLIT_MAX_CONNECTION_ERRORS > 0
+}
+
+bool transport_master_nodes(matrix_row_t node_matrix[]) {
+    static uint8_t next_node = 0;
+    bool           changed   = false;
+    uint8_t        polled    = 0;
+
+    for (uint8_t i = 0; i < SPLIT_EXTRA_NODES && polled < SPLIT_NODES_PER_SCAN; i++) {
+        uint8_t             node  = next_node;
+        split_node_state_t *state = &node_states[node];
+        matrix_row_t *      rows  = node_matrix + node * (SPLIT_EXTRA_NODE_ROWS);
+        next_node                 = (next_node + 1) % (SPLIT_EXTRA_NODES);
+
+        // Detached nodes are only retried every SPLIT_CONNECTION_CHECK_TIMEOUT, and don't use up this scan's budget
+        const bool is_disconnected = !is_node_connected(node);
+        if (is_disconnected && timer_elapsed(state->connection_check_timer) < SPLIT_CONNECTION_CHECK_TIMEOUT) {
+            continue;
+        }
+        polled++;
+
+        matrix_row_t temp[SPLIT_EXTRA_NODE_ROWS];
+        if (transactions_master_node(node, temp)) {
+            if (is_disconnected) {
+                dprintf("Node %u connected\n", node);
+            }
+            state->connection_errors = 0;
+            if (memcmp(rows, temp, sizeof(temp)) != 0) {
+                memcpy(rows, temp, sizeof(temp));
+                changed = true;
+            }
+            continue;
+        }
+
+        if (state->connection_errors < UINT8_MAX) {
+            state->connection_errors++;
+        }
+        if (!is_node_connected(node)) {
+            state->connection_check_timer = timer_read();
+            if (!is_disconnected) {
+                dprintf("Node %u disconnected, throttling connection attempts\n", node);
+                // release any keys held on the detached node
+                memset(rows, 0, sizeof(temp));
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+#endif // SPLIT_EXTRA_NODES
@@ -15,6 +15,12 @@ void split_post_init(void);
 bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 bool is_transport_connected(void);
 
+#ifdef SPLIT_EXTRA_NODES
+// Polls the extra nodes that are due this scan, updating their rows within node_matrix. Returns true if any row changed.
+bool transport_master_nodes(matrix_row_t node_matrix[]);
+bool is_node_connected(uint8_t node);
+#endif // SPLIT_EXTRA_NODES
+
 void split_watchdog_update(bool done);
 void split_watchdog_task(void);
 bool split_watchdog_check(void);
\ No newline at end of file
@@ -0,0 +1,27 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 4
+
+#define DISABLE_SYNC_TIMER
+#define FORCED_SYNC_THROTTLE_MS 100
+#define SPLIT_SYNC_THROTTLE_MS 50
+
+// Keep the RPC buffers small so that queued RPCs need to be fragmented
+#define RPC_M2S_BUFFER_SIZE 8
+#define RPC_S2M_BUFFER_SIZE 8
+
+#define SPLIT_TRANSACTION_IDS_USER USER_RPC_ECHO
+
+#define SPLIT_OLED_BUFFER_ENABLE
+
+#define SPLIT_SYNC_STATES_USER                                                    \
+    SPLIT_SYNC_STATE(m2s_flag, bool, SPLIT_SYNC_M2S, SPLIT_SYNC_ON_CHANGE)        \
+    SPLIT_SYNC_STATE(m2s_counter, uint16_t, SPLIT_SYNC_M2S, SPLIT_SYNC_THROTTLED) \
+    SPLIT_SYNC_STATE(s2m_value, uint32_t, SPLIT_SYNC_S2M, SPLIT_SYNC_ON_CHANGE)
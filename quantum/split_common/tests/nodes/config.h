@@ -0,0 +1,21 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+// One row on each half, followed by one row on each extra node
+#define MATRIX_ROWS 5
+#define MATRIX_COLS 4
+
+#define USE_I2C
+#define SPLIT_EXTRA_NODES 3
+#define SPLIT_EXTRA_NODE_ROWS 1
+#define SPLIT_NODES_PER_SCAN 2
+#define SPLIT_MAX_CONNECTION_ERRORS 3
+#define SPLIT_CONNECTION_CHECK_TIMEOUT 500
+
+#define DISABLE_SYNC_TIMER
+#define FORCED_SYNC_THROTTLE_MS 100
@@ -0,0 +1,26 @@
+# The letter case of these variables might seem odd. However:
+# - it is consistent with the example that is used as a reference in the Unit Testing article (https://docs.qmk.fm/#/unit_testing?id=adding-tests-for-new-or-existing-features)
+# - Neither `make test:split_transactions` or `make test:SPLIT_TRANSACTIONS` work when using SCREAMING_SNAKE_CASE
+
+split_transactions_DEFS := -DSPLIT_KEYBOARD -DSPLIT_COMMON_TRANSACTIONS -DOLED_ENABLE -DNO_DEBUG -DNO_PRINT
+split_transactions_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+split_transactions_INC := $(QUANTUM_PATH)/split_common $(DRIVER_PATH)/oled
+
+split_transactions_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_sim.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transactions_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+split_nodes_DEFS := -DSPLIT_KEYBOARD -DSPLIT_COMMON_TRANSACTIONS -DNO_DEBUG -DNO_PRINT
+split_nodes_CONFIG := $(QUANTUM_PATH)/split_common/tests/nodes/config.h
+split_nodes_INC := $(QUANTUM_PATH)/split_common $(QUANTUM_PATH)/split_common/tests/nodes
+
+split_nodes_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_sim.c \
+	$(QUANTUM_PATH)/split_common/tests/split_nodes_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/split_util.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
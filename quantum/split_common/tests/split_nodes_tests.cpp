@@ -0,0 +1,105 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_sim.h"
+#include "split_util.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class SplitNodesTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // The connection check timers keep running, so time only ever moves forward between tests
+        advance_time(SPLIT_CONNECTION_CHECK_TIMEOUT);
+        split_sim_link_config_t config = SPLIT_SIM_LINK_DEFAULTS;
+        split_sim_init(&config);
+
+        // Reattach anything left detached by a previous test
+        ScanUntilConnected();
+        memset(split_sim_master.node_matrix, 0, sizeof(split_sim_master.node_matrix));
+        split_sim_reset_stats();
+    }
+
+    void ScanUntilConnected() {
+        for (int i = 0; i < 10; ++i) {
+            bool all_connected = true;
+            for (uint8_t node = 0; node < SPLIT_EXTRA_NODES; ++node) {
+                all_connected &= is_node_connected(node);
+            }
+            if (all_connected) return;
+            advance_time(SPLIT_CONNECTION_CHECK_TIMEOUT);
+            split_sim_scan();
+        }
+    }
+
+    // Scans until every node has been polled once
+    void ScanAllNodes() {
+        for (int i = 0; i < (SPLIT_EXTRA_NODES + SPLIT_NODES_PER_SCAN - 1) / SPLIT_NODES_PER_SCAN; ++i) {
+            split_sim_scan();
+        }
+    }
+};
+
+TEST_F(SplitNodesTest, NodeRowsReachMaster) {
+    split_sim_nodes[0].own_matrix[0] = 0b0001;
+    split_sim_nodes[2].own_matrix[0] = 0b1010;
+    ScanAllNodes();
+
+    EXPECT_EQ(split_sim_master.node_matrix[0 * SPLIT_EXTRA_NODE_ROWS], 0b0001);
+    EXPECT_EQ(split_sim_master.node_matrix[1 * SPLIT_EXTRA_NODE_ROWS], 0);
+    EXPECT_EQ(split_sim_master.node_matrix[2 * SPLIT_EXTRA_NODE_ROWS], 0b1010);
+}
+
+TEST_F(SplitNodesTest, AtMostNodesPerScanArePolled) {
+    uint32_t polled = 0;
+    for (int scan = 0; scan < 2 * SPLIT_EXTRA_NODES; ++scan) {
+        split_sim_scan();
+        uint32_t total = 0;
+        for (uint8_t node = 0; node < SPLIT_EXTRA_NODES; ++node) {
+            total += split_sim_stats()->node_transactions[node];
+        }
+        EXPECT_EQ(total - polled, SPLIT_NODES_PER_SCAN);
+        polled = total;
+    }
+
+    // Round-robin, so every node gets its share
+    for (uint8_t node = 0; node < SPLIT_EXTRA_NODES; ++node) {
+        EXPECT_EQ(split_sim_stats()->node_transactions[node], 4);
+    }
+}
+
+TEST_F(SplitNodesTest, DetachedNodeReleasesItsKeys) {
+    split_sim_nodes[1].own_matrix[0] = 0b0110;
+    split_sim_nodes[2].own_matrix[0] = 0b0001;
+    ScanAllNodes();
+    EXPECT_EQ(split_sim_master.node_matrix[1 * SPLIT_EXTRA_NODE_ROWS], 0b0110);
+
+    // Keys stay held across the odd failed poll, and are released once the node counts as detached
+    split_sim_nodes[1].attached = false;
+    while (is_node_connected(1)) {
+        EXPECT_EQ(split_sim_master.node_matrix[1 * SPLIT_EXTRA_NODE_ROWS], 0b0110);
+        split_sim_scan();
+    }
+    EXPECT_EQ(split_sim_master.node_matrix[1 * SPLIT_EXTRA_NODE_ROWS], 0);
+    EXPECT_EQ(split_sim_master.node_matrix[2 * SPLIT_EXTRA_NODE_ROWS], 0b0001);
+
+    // Not retried before the connection check timeout, which leaves the budget to the other nodes
+    split_sim_reset_stats();
+    for (int i = 0; i < 5; ++i) {
+        split_sim_scan();
+    }
+    EXPECT_EQ(split_sim_stats()->node_transactions[1], 0);
+    EXPECT_EQ(split_sim_stats()->node_transactions[0] + split_sim_stats()->node_transactions[2], 5 * SPLIT_NODES_PER_SCAN);
+
+    // Reattaching brings its keys back on the next attempt
+    split_sim_nodes[1].attached = true;
+    advance_time(SPLIT_CONNECTION_CHECK_TIMEOUT);
+    ScanAllNodes();
+    EXPECT_TRUE(is_node_connected(1));
+    EXPECT_EQ(split_sim_master.node_matrix[1 * SPLIT_EXTRA_NODE_ROWS], 0b0110);
+}
@@ -0,0 +1,275 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc.h"
+#include "split_sim.h"
+#include "timer.h"
+#include "transactions.h"
+#include "transport.h"
+
+#ifdef SPLIT_EXTRA_NODES
+#    include "split_util.h"
+#endif
+
+void advance_time(uint32_t ms);
+
+#define SPLIT_SIM_MAX_STATES 8
+
+typedef struct {
+    void * state;
+    size_t size;
+    void * saved[2]; // inactive copy for each half
+} split_sim_state_t;
+
+static split_shared_memory_t shared_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+
+split_sim_half_t split_sim_master;
+split_sim_half_t split_sim_slave;
+#ifdef SPLIT_EXTRA_NODES
+split_sim_node_t split_sim_nodes[SPLIT_EXTRA_NODES];
+#endif // SPLIT_EXTRA_NODES
+
+static split_sim_link_config_t link_config;
+static split_sim_stats_t       link_stats;
+static split_sim_state_t       states[SPLIT_SIM_MAX_STATES];
+static uint8_t                 num_states     = 0;
+static split_sim_side_t        current_side   = SPLIT_SIM_MASTER;
+static uint32_t                random_state   = 1;
+static uint32_t                time_remainder = 0;
+static bool                    connected      = true;
+
+static uint32_t split_sim_random(void) {
+    // xorshift32, deterministic for a given seed
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static bool split_sim_chance(uint32_t per_million) {
+    return per_million && (split_sim_random() % 1000000) < per_million;
+}
+
+static void split_sim_advance_us(uint32_t us) {
+    time_remainder += us;
+    advance_time(time_remainder / 1000);
+    time_remainder %= 1000;
+    link_stats.link_time_us += us;
+}
+
+static void split_sim_switch_to(split_sim_side_t side) {
+    if (side == current_side) return;
+    for (uint8_t i = 0; i < num_states; ++i) {
+        memcpy(states[i].saved[current_side], states[i].state, states[i].size);
+        memcpy(states[i].state, states[i].saved[side], states[i].size);
+    }
+    current_side = side;
+}
+
+static void *split_sim_peer_copy(void *state) {
+    for (uint8_t i = 0; i < num_states; ++i) {
+        if (states[i].state == state) {
+            return states[i].saved[current_side == SPLIT_SIM_MASTER ? SPLIT_SIM_SLAVE : SPLIT_SIM_MASTER];
+        }
+    }
+    return NULL;
+}
+
+void split_sim_register_state(void *state, size_t size) {
+    if (num_states >= SPLIT_SIM_MAX_STATES) abort();
+    states[num_states] = (split_sim_state_t){
+        .state = state,
+        .size  = size,
+        .saved = {calloc(1, size), calloc(1, size)},
+    };
+    // Both halves start out from the current contents
+    memcpy(states[num_states].saved[SPLIT_SIM_MASTER], state, size);
+    memcpy(states[num_states].saved[SPLIT_SIM_SLAVE], state, size);
+    ++num_states;
+}
+
+void split_sim_init(const split_sim_link_config_t *config) {
+    for (uint8_t i = 0; i < num_states; ++i) {
+        free(states[i].saved[SPLIT_SIM_MASTER]);
+        free(states[i].saved[SPLIT_SIM_SLAVE]);
+    }
+    num_states   = 0;
+    current_side = SPLIT_SIM_MASTER;
+    connected    = true;
+
+    link_config    = *config;
+    random_state   = config->seed ? config->seed : 1;
+    time_remainder = 0;
+    memset(&link_stats, 0, sizeof(link_stats));
+    memset(&shared_memory, 0, sizeof(shared_memory));
+    memset(&split_sim_master, 0, sizeof(split_sim_master));
+    memset(&split_sim_slave, 0, sizeof(split_sim_slave));
+#ifdef SPLIT_EXTRA_NODES
+    for (uint8_t node = 0; node < SPLIT_EXTRA_NODES; ++node) {
+        split_sim_nodes[node] = (split_sim_node_t){.attached = true};
+    }
+#endif // SPLIT_EXTRA_NODES
+
+    split_sim_register_state(&shared_memory, sizeof(shared_memory));
+    split_sim_register_state(split_transaction_table, sizeof(split_transaction_table));
+}
+
+void split_sim_set_connected(bool state) {
+    connected = state;
+}
+
+void split_sim_run_on(split_sim_side_t side, void (*fn)(void *), void *arg) {
+    split_sim_side_t previous = current_side;
+    split_sim_switch_to(side);
+    fn(arg);
+    split_sim_switch_to(previous);
+}
+
+static void split_sim_master_scan(void *arg) {
+    *(bool *)arg = transactions_master(split_sim_master.own_matrix, split_sim_master.peer_matrix);
+#ifdef SPLIT_EXTRA_NODES
+    transport_master_nodes(split_sim_master.node_matrix);
+#endif // SPLIT_EXTRA_NODES
+}
+
+static void split_sim_slave_scan(void *arg) {
+    transactions_slave(split_sim_slave.peer_matrix, split_sim_slave.own_matrix);
+}
+
+bool split_sim_scan(void) {
+    bool okay = false;
+    split_sim_run_on(SPLIT_SIM_SLAVE, split_sim_slave_scan, NULL);
+    split_sim_run_on(SPLIT_SIM_MASTER, split_sim_master_scan, &okay);
+    return okay;
+}
+
+split_sim_side_t split_sim_current_side(void) {
+    return current_side;
+}
+
+const split_sim_stats_t *split_sim_stats(void) {
+    return &link_stats;
+}
+
+void split_sim_reset_stats(void) {
+    memset(&link_stats, 0, sizeof(link_stats));
+}
+
+uint64_t split_sim_time_us(void) {
+    return (uint64_t)timer_read32() * 1000 + time_remainder;
+}
+
+#ifndef SPLIT_EXTRA_NODES
+// split_util.c provides its own when linked in for the extra nodes
+bool is_transport_connected(void) {
+    return connected;
+}
+#endif // SPLIT_EXTRA_NODES
+
+bool is_keyboard_master(void) {
+    return current_side == SPLIT_SIM_MASTER;
+}
+
+bool is_keyboard_left(void) {
+    return current_side == SPLIT_SIM_MASTER;
+}
+
+typedef struct {
+    split_transaction_desc_t *trans;
+} split_sim_callback_args_t;
+
+static void split_sim_slave_callback(void *arg) {
+    split_transaction_desc_t *trans = ((split_sim_callback_args_t *)arg)->trans;
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans        = &split_transaction_table[id];
+    uint8_t *                 slave_shmem  = split_sim_peer_copy(&shared_memory);
+    size_t                    i2t_len      = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+    size_t                    t2i_len      = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+    uint32_t                  wire_bytes   = link_config.overhead_bytes + i2t_len + t2i_len;
+    uint32_t                  wire_time_us = link_config.latency_us + (uint32_t)((uint64_t)wire_bytes * 10 * 1000000 / link_config.bit_rate);
+
+    ++link_stats.transactions;
+    link_stats.bytes += wire_bytes;
+    split_sim_advance_us(wire_time_us);
+
+    if (i2t_len > 0) {
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, i2t_len);
+    }
+
+    // Dropped transactions and corrupted bits are both caught by the transport, before the target acts on them
+    bool failed = !connected || split_sim_chance(link_config.drop_per_million);
+    for (uint32_t bit = 0; !failed && bit < wire_bytes * 8; ++bit) {
+        failed = split_sim_chance(link_config.bit_error_per_million);
+    }
+    if (failed) {
+        ++link_stats.failed_transactions;
+        return false;
+    }
+
+    if (i2t_len > 0) {
+        memcpy(slave_shmem + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), i2t_len);
+    }
+
+    split_sim_callback_args_t args = {.trans = trans};
+    split_sim_run_on(SPLIT_SIM_SLAVE, split_sim_slave_callback, &args);
+
+    // The target has already acted on the transaction, only the initiator sees it fail
+    if (split_sim_chance(link_config.ack_drop_per_million)) {
+        ++link_stats.failed_transactions;
+        return false;
+    }
+
+    if (t2i_len > 0) {
+        memcpy(split_trans_target2initiator_buffer(trans), slave_shmem + trans->target2initiator_offset, t2i_len);
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), t2i_len);
+    }
+
+    return true;
+}
+
+#ifdef SPLIT_EXTRA_NODES
+// Each node runs its own firmware, so only its reply is simulated: the checksum and rows a node would have
+// published, carried over the same link as the slave's transactions.
+bool transport_execute_node_transaction(uint8_t node, int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_node_matrix_sync_t reply;
+    uint32_t                 wire_bytes = link_config.overhead_bytes + sizeof(reply);
+
+    ++link_stats.transactions;
+    ++link_stats.node_transactions[node];
+    link_stats.bytes += wire_bytes;
+    split_sim_advance_us(link_config.latency_us + (uint32_t)((uint64_t)wire_bytes * 10 * 1000000 / link_config.bit_rate));
+
+    if (id != GET_NODE_MATRIX || target2initiator_length != sizeof(reply) || !split_sim_nodes[node].attached || split_sim_chance(link_config.drop_per_million)) {
+        ++link_stats.failed_transactions;
+        return false;
+    }
+
+    memcpy(reply.matrix, split_sim_nodes[node].own_matrix, sizeof(reply.matrix));
+    reply.checksum = crc8(reply.matrix, sizeof(reply.matrix));
+    memcpy(target2initiator_buf, &reply, sizeof(reply));
+    return true;
+}
+
+// The rest of the transport and the USB detection, as needed by split_util.c
+bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return transactions_master(master_matrix, slave_matrix);
+}
+
+void transport_master_init(void) {}
+void transport_slave_init(void) {}
+
+bool usb_vbus_state(void) {
+    return current_side == SPLIT_SIM_MASTER;
+}
+
+void usb_disconnect(void) {}
+#endif // SPLIT_EXTRA_NODES
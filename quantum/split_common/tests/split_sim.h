@@ -0,0 +1,92 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "matrix.h"
+#include "transport.h"
+
+/*
+ * Host-side split keyboard simulator.
+ *
+ * Both halves run in the same process: the master and slave each get their own
+ * copy of the split shared memory, the transaction table and any other state
+ * registered through split_sim_register_state(), which are swapped in and out
+ * whenever execution moves between the halves. Transactions issued by the
+ * master are carried over a virtual link with configurable latency, bit rate,
+ * drops and bit errors, and the simulated time spent on the link is accounted
+ * for through the test timer.
+ *
+ * With SPLIT_EXTRA_NODES, the extra nodes are simulated as well: their rows are
+ * handed to the master by transport_execute_node_transaction() as long as the
+ * node is attached, and split_util.c is linked in to poll them.
+ */
+
+#define SPLIT_SIM_ROWS_PER_HAND SPLIT_ROWS_PER_HAND
+
+typedef enum {
+    SPLIT_SIM_MASTER,
+    SPLIT_SIM_SLAVE,
+} split_sim_side_t;
+
+typedef struct {
+    uint32_t bit_rate;              // bits per second on the wire
+    uint32_t latency_us;            // fixed turnaround time per transaction
+    uint32_t overhead_bytes;        // framing bytes per transaction (id, checksums)
+    uint32_t drop_per_million;      // probability of a transaction not being answered
+    uint32_t bit_error_per_million; // probability of a single bit being corrupted, caught by the transport checksum
+    uint32_t ack_drop_per_million;  // probability of the target acting on a transaction, but its reply being lost
+    uint32_t seed;                  // seed for the deterministic random source
+} split_sim_link_config_t;
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t failed_transactions;
+    uint32_t bytes;
+    uint64_t link_time_us;
+#ifdef SPLIT_EXTRA_NODES
+    uint32_t node_transactions[SPLIT_EXTRA_NODES];
+#endif // SPLIT_EXTRA_NODES
+} split_sim_stats_t;
+
+typedef struct {
+    matrix_row_t own_matrix[SPLIT_SIM_ROWS_PER_HAND];
+    matrix_row_t peer_matrix[SPLIT_SIM_ROWS_PER_HAND];
+#ifdef SPLIT_EXTRA_NODES
+    matrix_row_t node_matrix[SPLIT_EXTRA_ROWS];
+#endif // SPLIT_EXTRA_NODES
+} split_sim_half_t;
+
+extern split_sim_half_t split_sim_master;
+extern split_sim_half_t split_sim_slave;
+
+#ifdef SPLIT_EXTRA_NODES
+typedef struct {
+    bool         attached;
+    matrix_row_t own_matrix[SPLIT_EXTRA_NODE_ROWS];
+} split_sim_node_t;
+
+extern split_sim_node_t split_sim_nodes[SPLIT_EXTRA_NODES];
+#endif // SPLIT_EXTRA_NODES
+
+// Serial link defaults, roughly matching SELECT_SOFT_SERIAL_SPEED 1
+#define SPLIT_SIM_LINK_DEFAULTS \
+    { .bit_rate = 137000, .latency_us = 20, .overhead_bytes = 3, .drop_per_million = 0, .bit_error_per_million = 0, .ack_drop_per_million = 0, .seed = 1 }
+
+void split_sim_init(const split_sim_link_config_t *config);
+void split_sim_register_state(void *state, size_t size);
+void split_sim_set_connected(bool connected);
+
+// Runs the code in fn as if it were executing on the given half
+void split_sim_run_on(split_sim_side_t side, void (*fn)(void *), void *arg);
+
+// Runs one slave scan, followed by one master scan. Returns the master transport result.
+bool split_sim_scan(void);
+
+split_sim_side_t         split_sim_current_side(void);
+const split_sim_stats_t *split_sim_stats(void);
+void                     split_sim_reset_stats(void);
+uint64_t                 split_sim_time_us(void);
@@ -0,0 +1,388 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "crc.h"
+#include "split_sim.h"
+#include "timer.h"
+#include "transactions.h"
+
+void advance_time(uint32_t ms);
+}
+
+static uint8_t sync_updates[2][NUM_SPLIT_SYNC_STATES];
+
+extern "C" void split_sync_state_updated_user(uint8_t state_id) {
+    ++sync_updates[split_sim_current_side()][state_id];
+}
+
+static uint8_t rpc_received[64];
+static uint8_t rpc_fragments_received;
+
+static void echo_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    const uint8_t *in  = (const uint8_t *)in_data;
+    uint8_t *      out = (uint8_t *)out_data;
+    memcpy(&rpc_received[transaction_rpc_fragment() * RPC_M2S_BUFFER_SIZE], in, in_buflen);
+    for (uint8_t i = 0; i < out_buflen; ++i) {
+        out[i] = (i < in_buflen) ? in[i] ^ 0xFF : 0;
+    }
+    ++rpc_fragments_received;
+}
+
+static void register_echo_handler(void *arg) {
+    transaction_register_rpc(USER_RPC_ECHO, echo_slave_handler);
+}
+
+static void set_slave_value(void *arg) {
+    split_sync_states.s2m_value = *(uint32_t *)arg;
+}
+
+static void get_sync_states(void *arg) {
+    *(split_sync_states_t *)arg = split_sync_states;
+}
+
+static void corrupt_sync_layout(void *arg) {
+    // Stands in for a master flashed with a different state list
+    split_shmem->sync_m2s.layout ^= 0x5A5A;
+}
+
+static void get_rpc_info(void *arg) {
+    *(rpc_sync_info_t *)arg = split_shmem->rpc_info;
+}
+
+// Runs the echo RPC by hand, as a master with its own sequence numbering would
+static bool exec_echo_rpc(uint8_t sequence, bool new_session) {
+    rpc_sync_info_t info = {};
+    info.payload.transaction_id = USER_RPC_ECHO;
+    info.payload.fragment_count = 1;
+    info.payload.sequence       = sequence;
+    info.payload.new_session    = new_session;
+    info.checksum               = crc8(&info.payload, sizeof(info.payload));
+
+    int8_t transaction_id = USER_RPC_ECHO;
+    return transport_execute_transaction(PUT_RPC_INFO, &info, sizeof(info), NULL, 0) && transport_execute_transaction(EXECUTE_RPC, &transaction_id, sizeof(transaction_id), NULL, 0);
+}
+
+static uint8_t         oled_buffer[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_split_dirty;
+
+// Minimal stand-in for the OLED driver's split buffer sync
+extern "C" bool oled_split_read_block(uint8_t *block, uint8_t *data) {
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        if (oled_split_dirty & ((OLED_BLOCK_TYPE)1 << i)) {
+            oled_split_dirty &= ~((OLED_BLOCK_TYPE)1 << i);
+            *block = i;
+            memcpy(data, &oled_buffer[OLED_BLOCK_SIZE * i], OLED_BLOCK_SIZE);
+            return true;
+        }
+    }
+    return false;
+}
+
+extern "C" void oled_split_mark_block(uint8_t block) {
+    oled_split_dirty |= ((OLED_BLOCK_TYPE)1 << block);
+}
+
+extern "C" void oled_split_write_block(uint8_t block, const uint8_t *data) {
+    memcpy(&oled_buffer[OLED_BLOCK_SIZE * block], data, OLED_BLOCK_SIZE);
+}
+
+static void get_oled_buffer(void *arg) {
+    memcpy(arg, oled_buffer, sizeof(oled_buffer));
+}
+
+static int  rpc_completions;
+static bool rpc_success;
+
+static void rpc_done(int8_t transaction_id, bool success, void *context) {
+    ++rpc_completions;
+    rpc_success = success;
+}
+
+class SplitTransactionsTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        split_sim_link_config_t config = SPLIT_SIM_LINK_DEFAULTS;
+        Init(config);
+    }
+
+    void Init(const split_sim_link_config_t &config) {
+        // The transaction handlers keep their own timestamps, so time only ever moves forward between tests
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        memset(&split_sync_states, 0, sizeof(split_sync_states));
+        memset(sync_updates, 0, sizeof(sync_updates));
+        memset(rpc_received, 0, sizeof(rpc_received));
+        memset(oled_buffer, 0, sizeof(oled_buffer));
+        oled_split_dirty = 0;
+        rpc_fragments_received = 0;
+        rpc_completions        = 0;
+        rpc_success            = false;
+
+        split_sim_init(&config);
+        split_sim_register_state(&split_sync_states, sizeof(split_sync_states));
+        split_sim_register_state(rpc_received, sizeof(rpc_received));
+        split_sim_register_state(oled_buffer, sizeof(oled_buffer));
+        split_sim_register_state(&oled_split_dirty, sizeof(oled_split_dirty));
+        split_sim_run_on(SPLIT_SIM_SLAVE, register_echo_handler, NULL);
+
+        // Settle the initial forced syncs
+        split_sim_scan();
+        split_sim_reset_stats();
+    }
+
+    split_sync_states_t SlaveStates() {
+        split_sync_states_t states;
+        split_sim_run_on(SPLIT_SIM_SLAVE, get_sync_states, &states);
+        return states;
+    }
+};
+
+TEST_F(SplitTransactionsTest, SlaveMatrixReachesMasterInOneScan) {
+    split_sim_slave.own_matrix[0] = 0b0101;
+    EXPECT_TRUE(split_sim_scan());
+    EXPECT_EQ(split_sim_master.peer_matrix[0], 0b0101);
+}
+
+TEST_F(SplitTransactionsTest, SlaveMatrixRecoversFromDroppedTransactions) {
+    split_sim_link_config_t config = SPLIT_SIM_LINK_DEFAULTS;
+    config.drop_per_million        = 500000;
+    Init(config);
+
+    split_sim_slave.own_matrix[1] = 0b1000;
+    for (int i = 0; i < 20 && split_sim_master.peer_matrix[1] != 0b1000; ++i) {
+        split_sim_scan();
+    }
+    EXPECT_EQ(split_sim_master.peer_matrix[1], 0b1000);
+    EXPECT_GT(split_sim_stats()->failed_transactions, 0u);
+}
+
+TEST_F(SplitTransactionsTest, BitErrorsNeverCorruptTheMatrix) {
+    split_sim_link_config_t config = SPLIT_SIM_LINK_DEFAULTS;
+    config.bit_error_per_million   = 2000;
+    Init(config);
+
+    matrix_row_t previous = 0;
+    for (int i = 0; i < 200; ++i) {
+        matrix_row_t next             = (i * 7) & 0xF;
+        split_sim_slave.own_matrix[0] = next;
+        split_sim_scan();
+        matrix_row_t seen = split_sim_master.peer_matrix[0];
+        EXPECT_TRUE(seen == previous || seen == next) << "scan " << i;
+        previous = seen;
+    }
+    EXPECT_GT(split_sim_stats()->failed_transactions, 0u);
+}
+
+TEST_F(SplitTransactionsTest, SyncStateOnChangeIsSentOnNextScan) {
+    // The master sends during its scan, the slave unpacks it on its next one
+    split_sync_states.m2s_flag = true;
+    split_sim_scan();
+    EXPECT_FALSE(SlaveStates().m2s_flag);
+    split_sim_scan();
+    EXPECT_TRUE(SlaveStates().m2s_flag);
+    EXPECT_EQ(sync_updates[SPLIT_SIM_SLAVE][SPLIT_SYNC_ID_m2s_flag], 1);
+
+    // Nothing changed, so the slave must not be notified again
+    split_sim_scan();
+    EXPECT_EQ(sync_updates[SPLIT_SIM_SLAVE][SPLIT_SYNC_ID_m2s_flag], 1);
+}
+
+TEST_F(SplitTransactionsTest, SyncStateThrottledIsDelayed) {
+    advance_time(SPLIT_SYNC_THROTTLE_MS);
+    split_sync_states.m2s_counter = 1;
+    split_sim_scan();
+    split_sim_scan();
+    EXPECT_EQ(SlaveStates().m2s_counter, 1);
+
+    split_sync_states.m2s_counter = 2;
+    split_sim_scan();
+    split_sim_scan();
+    EXPECT_EQ(SlaveStates().m2s_counter, 1);
+
+    advance_time(SPLIT_SYNC_THROTTLE_MS);
+    split_sim_scan();
+    split_sim_scan();
+    EXPECT_EQ(SlaveStates().m2s_counter, 2);
+}
+
+TEST_F(SplitTransactionsTest, SyncStatesAreBatched) {
+    split_sim_scan();
+    uint32_t idle_transactions = split_sim_stats()->transactions;
+    split_sim_reset_stats();
+
+    advance_time(SPLIT_SYNC_THROTTLE_MS);
+    split_sync_states.m2s_flag    = true;
+    split_sync_states.m2s_counter = 42;
+    split_sim_scan();
+    EXPECT_EQ(split_sim_stats()->transactions, idle_transactions + 1);
+    split_sim_scan();
+    EXPECT_TRUE(SlaveStates().m2s_flag);
+    EXPECT_EQ(SlaveStates().m2s_counter, 42);
+}
+
+TEST_F(SplitTransactionsTest, SyncStateSlaveToMaster) {
+    uint32_t value = 0xC0FFEE;
+    split_sim_run_on(SPLIT_SIM_SLAVE, set_slave_value, &value);
+
+    split_sim_scan();
+    EXPECT_EQ(split_sync_states.s2m_value, 0xC0FFEE);
+    EXPECT_EQ(sync_updates[SPLIT_SIM_MASTER][SPLIT_SYNC_ID_s2m_value], 1);
+}
+
+TEST_F(SplitTransactionsTest, SyncStatesWithAnotherLayoutAreIgnored) {
+    split_sync_states.m2s_flag = true;
+    split_sim_scan();
+    split_sim_run_on(SPLIT_SIM_SLAVE, corrupt_sync_layout, NULL);
+    split_sim_scan();
+    EXPECT_FALSE(SlaveStates().m2s_flag);
+    EXPECT_EQ(sync_updates[SPLIT_SIM_SLAVE][SPLIT_SYNC_ID_m2s_flag], 0);
+
+    // The next forced resync carries the matching layout again
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    split_sim_scan();
+    split_sim_scan();
+    EXPECT_TRUE(SlaveStates().m2s_flag);
+}
+
+TEST_F(SplitTransactionsTest, QueuedRpcIsFragmented) {
+    uint8_t request[20];
+    uint8_t response[20] = {0};
+    for (uint8_t i = 0; i < sizeof(request); ++i) {
+        request[i] = i + 1;
+    }
+
+    EXPECT_TRUE(transaction_rpc_exec_async(USER_RPC_ECHO, sizeof(request), request, sizeof(response), response, rpc_done, NULL));
+    EXPECT_EQ(transaction_rpc_async_pending(), 1);
+
+    int scans = 0;
+    while (rpc_completions == 0 && scans < 20) {
+        split_sim_scan();
+        ++scans;
+    }
+
+    EXPECT_EQ(rpc_completions, 1);
+    EXPECT_TRUE(rpc_success);
+    EXPECT_EQ(transaction_rpc_async_pending(), 0);
+    // 3 fragments, with info, request data and execute stages each
+    EXPECT_EQ(scans, 9);
+    EXPECT_EQ(rpc_fragments_received, 3);
+
+    uint8_t slave_received[64];
+    split_sim_run_on(
+        SPLIT_SIM_SLAVE, [](void *arg) { memcpy(arg, rpc_received, sizeof(rpc_received)); }, slave_received);
+    for (uint8_t i = 0; i < sizeof(request); ++i) {
+        EXPECT_EQ(slave_received[i], request[i]);
+        EXPECT_EQ(response[i], request[i] ^ 0xFF);
+    }
+}
+
+TEST_F(SplitTransactionsTest, QueuedRpcResumesAfterDisconnect) {
+    uint8_t request[4] = {1, 2, 3, 4};
+    EXPECT_TRUE(transaction_rpc_exec_async(USER_RPC_ECHO, sizeof(request), request, 0, NULL, rpc_done, NULL));
+
+    split_sim_set_connected(false);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(split_sim_scan());
+    }
+    EXPECT_EQ(rpc_completions, 0);
+    EXPECT_EQ(transaction_rpc_async_pending(), 1);
+
+    split_sim_set_connected(true);
+    for (int i = 0; i < 5 && rpc_completions == 0; ++i) {
+        split_sim_scan();
+    }
+    EXPECT_EQ(rpc_completions, 1);
+    EXPECT_TRUE(rpc_success);
+}
+
+TEST_F(SplitTransactionsTest, QueuedRpcFragmentsRunOnceDespiteLostReplies) {
+    split_sim_link_config_t config = SPLIT_SIM_LINK_DEFAULTS;
+    config.ack_drop_per_million    = 300000;
+    Init(config);
+
+    uint8_t request[20];
+    uint8_t response[20] = {0};
+    for (uint8_t i = 0; i < sizeof(request); ++i) {
+        request[i] = i + 1;
+    }
+
+    EXPECT_TRUE(transaction_rpc_exec_async(USER_RPC_ECHO, sizeof(request), request, sizeof(response), response, rpc_done, NULL));
+    for (int i = 0; i < 200 && rpc_completions == 0; ++i) {
+        split_sim_scan();
+    }
+
+    EXPECT_EQ(rpc_completions, 1);
+    EXPECT_TRUE(rpc_success);
+    EXPECT_EQ(rpc_fragments_received, 3);
+    EXPECT_GT(split_sim_stats()->failed_transactions, 0u);
+    for (uint8_t i = 0; i < sizeof(response); ++i) {
+        EXPECT_EQ(response[i], request[i] ^ 0xFF);
+    }
+}
+
+TEST_F(SplitTransactionsTest, RestartedMasterRpcIsNotSkipped) {
+    uint8_t request[4] = {1, 2, 3, 4};
+    EXPECT_TRUE(transaction_rpc_exec(USER_RPC_ECHO, sizeof(request), request, 0, NULL));
+    EXPECT_EQ(rpc_fragments_received, 1);
+
+    rpc_sync_info_t last;
+    split_sim_run_on(SPLIT_SIM_SLAVE, get_rpc_info, &last);
+
+    // A retry of the same fragment only reads the response back
+    EXPECT_TRUE(exec_echo_rpc(last.payload.sequence, false));
+    EXPECT_EQ(rpc_fragments_received, 1);
+
+    // After a master-only reset, its first RPC may well reuse the sequence the slave saw last
+    EXPECT_TRUE(exec_echo_rpc(last.payload.sequence, true));
+    EXPECT_EQ(rpc_fragments_received, 2);
+}
+
+TEST_F(SplitTransactionsTest, OledBlockIsAppliedFromSlaveMainLoop) {
+    memset(&oled_buffer[OLED_BLOCK_SIZE * 3], 0xA5, OLED_BLOCK_SIZE);
+    oled_split_mark_block(3);
+
+    uint8_t slave_buffer[OLED_MATRIX_SIZE];
+    split_sim_scan();
+    split_sim_run_on(SPLIT_SIM_SLAVE, get_oled_buffer, slave_buffer);
+    // Only staged by the transaction, not yet written to the slave's buffer
+    EXPECT_EQ(slave_buffer[OLED_BLOCK_SIZE * 3], 0);
+
+    split_sim_scan();
+    split_sim_run_on(SPLIT_SIM_SLAVE, get_oled_buffer, slave_buffer);
+    EXPECT_EQ(memcmp(slave_buffer, oled_buffer, sizeof(oled_buffer)), 0);
+}
+
+TEST_F(SplitTransactionsTest, KeyLatencyAndThroughput) {
+    uint64_t total_latency_us = 0;
+    int      presses          = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        matrix_row_t next = (i / 10) & 0xF;
+        if (next != split_sim_slave.own_matrix[0]) {
+            split_sim_slave.own_matrix[0] = next;
+            uint64_t pressed_at           = split_sim_time_us();
+            while (split_sim_master.peer_matrix[0] != next) {
+                split_sim_scan();
+            }
+            total_latency_us += split_sim_time_us() - pressed_at;
+            ++presses;
+        } else {
+            split_sim_scan();
+        }
+    }
+
+    const split_sim_stats_t *stats            = split_sim_stats();
+    uint64_t                 avg_latency_us   = total_latency_us / presses;
+    uint64_t                 avg_scan_link_us = stats->link_time_us / 1000;
+    uint64_t                 bytes_per_second = (uint64_t)stats->bytes * 1000000 / stats->link_time_us;
+    RecordProperty("avg_key_latency_us", (int)avg_latency_us);
+    RecordProperty("avg_scan_link_time_us", (int)avg_scan_link_us);
+    RecordProperty("link_bytes_per_second", (int)bytes_per_second);
+
+    // Every key change must make it across within a single scan's worth of link time
+    EXPECT_LE(avg_latency_us, avg_scan_link_us * 2);
+    EXPECT_LT(avg_latency_us, 2000u);
+    EXPECT_EQ(stats->failed_transactions, 0u);
+}
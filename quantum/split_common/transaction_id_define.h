@@ -24,6 +24,10 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_EXTRA_NODES
+    GET_NODE_MATRIX,
+#endif // SPLIT_EXTRA_NODES
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -74,6 +78,10 @@ enum serial_transaction_id {
     PUT_OLED,
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+    PUT_OLED_BUFFER,
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
     PUT_ST7565,
 #endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
@@ -88,6 +96,12 @@ enum serial_transaction_id {
     PUT_WATCHDOG,
 #endif // defined(SPLIT_WATCHDOG_ENABLE)
 
+#if defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+    PUT_SYNC_STATES,
+    GET_SYNC_STATES_CHECKSUM,
+    GET_SYNC_STATES_DATA,
+#endif // defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
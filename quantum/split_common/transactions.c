@@ -43,6 +43,9 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
+#define trans_bidirectional_initializer_cb(i2t_member, t2i_member, cb) \
+    { sizeof_member(split_shared_memory_t, i2t_member), offsetof(split_shared_memory_t, i2t_member), sizeof_member(split_shared_memory_t, t2i_member), offsetof(split_shared_memory_t, t2i_member), cb }
+
 #define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 
@@ -138,8 +141,8 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
-    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
-    matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
+    static matrix_row_t last_matrix[SPLIT_ROWS_PER_HAND] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+    matrix_row_t        temp_matrix[SPLIT_ROWS_PER_HAND];       // holding area while we test whether or not checksum is correct
 
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
     if (okay) {
@@ -164,6 +167,44 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+////////////////////////////////////////////////////
+// Extra nodes
+
+#ifdef SPLIT_EXTRA_NODES
+
+bool transactions_master_node(uint8_t node, matrix_row_t node_matrix[]) {
+    split_node_matrix_sync_t temp;
+    if (!transport_execute_node_transaction(node, GET_NODE_MATRIX, NULL, 0, &temp, sizeof(temp))) {
+        return false;
+    }
+    if (temp.checksum != crc8(temp.matrix, sizeof(temp.matrix))) {
+        return false;
+    }
+    memcpy(node_matrix, temp.matrix, sizeof(temp.matrix));
+    return true;
+}
+
+#    ifdef SPLIT_NODE_ID
+// Only the nodes' own firmware publishes a node matrix
+static void node_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    memcpy(split_shmem->nmatrix.matrix, slave_matrix, sizeof(split_shmem->nmatrix.matrix));
+    split_shmem->nmatrix.checksum = crc8(split_shmem->nmatrix.matrix, sizeof(split_shmem->nmatrix.matrix));
+}
+#    endif // SPLIT_NODE_ID
+
+// clang-format off
+#    define TRANSACTIONS_NODE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(node_matrix)
+#    define TRANSACTIONS_NODE_MATRIX_REGISTRATIONS \
+    [GET_NODE_MATRIX] = trans_target2initiator_initializer(nmatrix),
+// clang-format on
+
+#else // SPLIT_EXTRA_NODES
+
+#    define TRANSACTIONS_NODE_MATRIX_SLAVE()
+#    define TRANSACTIONS_NODE_MATRIX_REGISTRATIONS
+
+#endif // SPLIT_EXTRA_NODES
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -599,6 +640,83 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
+////////////////////////////////////////////////////
+// OLED buffer
+
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+
+static bool oled_buffer_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_update   = 0;
+    static uint8_t  refresh_block = 0;
+
+    // Slowly walk through the whole buffer, in case the slave has missed or lost anything
+    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        oled_split_mark_block(refresh_block);
+        refresh_block = (refresh_block + 1) % OLED_BLOCK_COUNT;
+        last_update   = timer_read32();
+    }
+
+    split_oled_block_t oled_block;
+    for (uint8_t i = 0; i < SPLIT_OLED_BUFFER_BLOCKS_PER_SCAN && oled_split_read_block(&oled_block.block, oled_block.data); ++i) {
+        bool accepted = false;
+        if (!transport_execute_transaction(PUT_OLED_BUFFER, &oled_block, sizeof(oled_block), &accepted, sizeof(accepted))) {
+            oled_split_mark_block(oled_block.block);
+            return false;
+        }
+        // The slave has not caught up with the previous blocks yet, try again next scan
+        if (!accepted) {
+            oled_split_mark_block(oled_block.block);
+            break;
+        }
+    }
+    return true;
+}
+
+static void slave_oled_buffer_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Only stage the block here, the OLED buffer itself is owned by the slave main loop
+    const split_oled_block_t *oled_block = (const split_oled_block_t *)initiator2target_buffer;
+    split_oled_buffer_sync_t *staged     = &split_shmem->oled_staged;
+
+    uint8_t slot = 0;
+    while (slot < staged->count && staged->blocks[slot].block != oled_block->block) {
+        ++slot;
+    }
+
+    bool accepted = slot < SPLIT_OLED_BUFFER_BLOCKS_PER_SCAN;
+    if (accepted) {
+        memcpy(&staged->blocks[slot], oled_block, sizeof(split_oled_block_t));
+        if (slot == staged->count) {
+            ++staged->count;
+        }
+    }
+    *(bool *)target2initiator_buffer = accepted;
+}
+
+static void oled_buffer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_oled_buffer_sync_t staged;
+
+    split_shared_memory_lock();
+    memcpy(&staged, &split_shmem->oled_staged, sizeof(staged));
+    split_shmem->oled_staged.count = 0;
+    split_shared_memory_unlock();
+
+    for (uint8_t i = 0; i < staged.count; ++i) {
+        oled_split_write_block(staged.blocks[i].block, staged.blocks[i].data);
+    }
+}
+
+#    define TRANSACTIONS_OLED_BUFFER_MASTER() TRANSACTION_HANDLER_MASTER(oled_buffer)
+#    define TRANSACTIONS_OLED_BUFFER_SLAVE() TRANSACTION_HANDLER_SLAVE(oled_buffer)
+#    define TRANSACTIONS_OLED_BUFFER_REGISTRATIONS [PUT_OLED_BUFFER] = trans_bidirectional_initializer_cb(oled_block, oled_block_accepted, slave_oled_buffer_callback),
+
+#else // defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+
+#    define TRANSACTIONS_OLED_BUFFER_MASTER()
+#    define TRANSACTIONS_OLED_BUFFER_SLAVE()
+#    define TRANSACTIONS_OLED_BUFFER_REGISTRATIONS
+
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+
 ////////////////////////////////////////////////////
 // ST7565
 
@@ -748,6 +866,341 @@ static void watchdog_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #endif // defined(SPLIT_WATCHDOG_ENABLE)
 
+////////////////////////////////////////////////////
+// Synced states
+
+#if defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+
+#    ifndef SPLIT_SYNC_THROTTLE_MS
+#        define SPLIT_SYNC_THROTTLE_MS 50
+#    endif // SPLIT_SYNC_THROTTLE_MS
+
+_Static_assert(NUM_SPLIT_SYNC_STATES <= 32, "Max number of synced states exceeded");
+
+typedef struct _split_sync_desc_t {
+    uint16_t local_offset;
+    uint16_t shmem_offset;
+    uint8_t  size;
+    uint8_t  direction;
+    uint8_t  policy;
+} split_sync_desc_t;
+
+#    define SPLIT_SYNC_SHMEM_OFFSET(name, direction) SPLIT_SYNC_IF_M2S_##direction(offsetof(split_sync_m2s_data_t, name)) SPLIT_SYNC_IF_S2M_##direction(offsetof(split_sync_s2m_data_t, name))
+
+// clang-format off
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) \
+    [SPLIT_SYNC_ID_##name] = { \
+        offsetof(split_sync_states_t, name), \
+        SPLIT_SYNC_SHMEM_OFFSET(name, direction), \
+        sizeof_member(split_sync_states_t, name), \
+        direction, \
+        policy \
+    },
+static const split_sync_desc_t split_sync_table[NUM_SPLIT_SYNC_STATES] = {SPLIT_SYNC_STATES_ALL};
+#    undef SPLIT_SYNC_STATE
+
+// Hash over the batch offset, size and direction of every entry, in table order.
+// Halves flashed with different state lists disagree on it, and refuse each other's
+// batches rather than copying bytes into the wrong states. Never 0, so the slave's
+// zero-initialised shared memory is not mistaken for a batch.
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) \
+    + ((SPLIT_SYNC_SHMEM_OFFSET(name, direction) * 64u + sizeof_member(split_sync_states_t, name)) * 2u + direction) * (SPLIT_SYNC_ID_##name * 2u + 1u) * 40503u
+#    define SPLIT_SYNC_LAYOUT_HASH ((uint16_t)(NUM_SPLIT_SYNC_STATES SPLIT_SYNC_STATES_ALL))
+static const uint16_t split_sync_layout = SPLIT_SYNC_LAYOUT_HASH ? SPLIT_SYNC_LAYOUT_HASH : 1;
+#    undef SPLIT_SYNC_LAYOUT_HASH
+#    undef SPLIT_SYNC_STATE
+// clang-format on
+
+split_sync_states_t split_sync_states;
+
+__attribute__((weak)) void split_sync_state_updated_user(uint8_t state_id) {}
+
+__attribute__((weak)) void split_sync_state_updated_kb(uint8_t state_id) {
+    split_sync_state_updated_user(state_id);
+}
+
+#    define split_sync_local_ptr(desc) (((uint8_t *)&split_sync_states) + (desc)->local_offset)
+
+/**
+ * @brief Copies the local states of the given direction into a batch buffer.
+ * Returns true if any of them differed from the buffer contents. States using
+ * the throttled policy are only picked up when `include_throttled` is set.
+ */
+static bool split_sync_collect(uint8_t direction, uint8_t *batch, bool include_throttled) {
+    bool changed = false;
+    for (uint8_t i = 0; i < NUM_SPLIT_SYNC_STATES; ++i) {
+        const split_sync_desc_t *desc = &split_sync_table[i];
+        if (desc->direction != direction || (desc->policy == SPLIT_SYNC_THROTTLED && !include_throttled)) continue;
+        if (memcmp(batch + desc->shmem_offset, split_sync_local_ptr(desc), desc->size) != 0) {
+            memcpy(batch + desc->shmem_offset, split_sync_local_ptr(desc), desc->size);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Copies states of the given direction out of a received batch buffer,
+ * notifying the keyboard/user code about each state that changed.
+ */
+static void split_sync_apply(uint8_t direction, const uint8_t *batch) {
+    for (uint8_t i = 0; i < NUM_SPLIT_SYNC_STATES; ++i) {
+        const split_sync_desc_t *desc = &split_sync_table[i];
+        if (desc->direction != direction) continue;
+        if (memcmp(split_sync_local_ptr(desc), batch + desc->shmem_offset, desc->size) != 0) {
+            memcpy(split_sync_local_ptr(desc), batch + desc->shmem_offset, desc->size);
+            split_sync_state_updated_kb(i);
+        }
+    }
+}
+
+static bool sync_states_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay = true;
+
+    if (NUM_SPLIT_SYNC_M2S_STATES > 0) {
+        static uint32_t  last_update           = 0;
+        static uint32_t  last_throttled_update = 0;
+        split_sync_m2s_t m2s;
+        memcpy(&m2s, &split_shmem->sync_m2s, sizeof(m2s));
+
+        // Throttled states ride along whenever something is being sent anyway
+        bool throttle_expired = timer_elapsed32(last_throttled_update) >= SPLIT_SYNC_THROTTLE_MS;
+        bool changed          = split_sync_collect(SPLIT_SYNC_M2S, (uint8_t *)&m2s.data, throttle_expired);
+        if (m2s.layout != split_sync_layout) {
+            m2s.layout = split_sync_layout;
+            changed    = true;
+        }
+        if (!throttle_expired && (changed || timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS)) {
+            changed |= split_sync_collect(SPLIT_SYNC_M2S, (uint8_t *)&m2s.data, true);
+        }
+        okay = send_if_condition(PUT_SYNC_STATES, &last_update, changed, &m2s, sizeof(m2s));
+        if (okay && changed) {
+            last_throttled_update = last_update;
+        }
+    }
+
+    if (okay && NUM_SPLIT_SYNC_S2M_STATES > 0) {
+        static uint32_t        last_update = 0;
+        split_sync_s2m_batch_t temp_state;
+
+        okay = read_if_checksum_mismatch(GET_SYNC_STATES_CHECKSUM, GET_SYNC_STATES_DATA, &last_update, &temp_state, &split_shmem->sync_s2m.batch, sizeof(temp_state));
+        if (okay && temp_state.layout == split_sync_layout) {
+            split_sync_apply(SPLIT_SYNC_S2M, (const uint8_t *)&temp_state.data);
+        }
+    }
+
+    return okay;
+}
+
+static void sync_states_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (NUM_SPLIT_SYNC_M2S_STATES > 0) {
+        split_sync_m2s_t m2s;
+
+        split_shared_memory_lock();
+        memcpy(&m2s, &split_shmem->sync_m2s, sizeof(m2s));
+        split_shared_memory_unlock();
+
+        // Only states that differ get notified, so forced resyncs and a restarted master are both harmless
+        if (m2s.layout == split_sync_layout) {
+            split_sync_apply(SPLIT_SYNC_M2S, (const uint8_t *)&m2s.data);
+        }
+    }
+
+    if (NUM_SPLIT_SYNC_S2M_STATES > 0) {
+        static uint32_t        last_throttled_update = 0;
+        split_sync_s2m_batch_t batch;
+
+        split_shared_memory_lock();
+        memcpy(&batch, &split_shmem->sync_s2m.batch, sizeof(batch));
+        split_shared_memory_unlock();
+
+        bool throttle_expired = timer_elapsed32(last_throttled_update) >= SPLIT_SYNC_THROTTLE_MS;
+        bool changed          = split_sync_collect(SPLIT_SYNC_S2M, (uint8_t *)&batch.data, throttle_expired);
+        if (changed && !throttle_expired) {
+            split_sync_collect(SPLIT_SYNC_S2M, (uint8_t *)&batch.data, true);
+        }
+        if (changed) {
+            last_throttled_update = timer_read32();
+        }
+        batch.layout = split_sync_layout;
+
+        // Always publish the checksum, so the master never sees a stale one for the current data
+        split_shared_memory_lock();
+        memcpy(&split_shmem->sync_s2m.batch, &batch, sizeof(batch));
+        split_shmem->sync_s2m.checksum = crc8(&batch, sizeof(batch));
+        split_shared_memory_unlock();
+    }
+}
+
+// clang-format off
+#    define TRANSACTIONS_SYNC_STATES_MASTER() TRANSACTION_HANDLER_MASTER(sync_states)
+#    define TRANSACTIONS_SYNC_STATES_SLAVE() TRANSACTION_HANDLER_SLAVE(sync_states)
+#    define TRANSACTIONS_SYNC_STATES_REGISTRATIONS \
+    [PUT_SYNC_STATES]          = trans_initiator2target_initializer(sync_m2s), \
+    [GET_SYNC_STATES_CHECKSUM] = trans_target2initiator_initializer(sync_s2m.checksum), \
+    [GET_SYNC_STATES_DATA]     = trans_target2initiator_initializer(sync_s2m.batch),
+// clang-format on
+
+#else // defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+
+#    define TRANSACTIONS_SYNC_STATES_MASTER()
+#    define TRANSACTIONS_SYNC_STATES_SLAVE()
+#    define TRANSACTIONS_SYNC_STATES_REGISTRATIONS
+
+#endif // defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+
+////////////////////////////////////////////////////
+// Queued RPC
+
+#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#    ifndef SPLIT_RPC_QUEUE_SIZE
+#        define SPLIT_RPC_QUEUE_SIZE 4
+#    endif // SPLIT_RPC_QUEUE_SIZE
+
+#    ifndef SPLIT_RPC_MAX_FAILURES
+#        define SPLIT_RPC_MAX_FAILURES 10
+#    endif // SPLIT_RPC_MAX_FAILURES
+
+typedef struct _split_rpc_request_t {
+    int8_t               transaction_id;
+    uint16_t             m2s_length;
+    const uint8_t *      m2s_buffer;
+    uint16_t             s2m_length;
+    uint8_t *            s2m_buffer;
+    split_rpc_callback_t callback;
+    void *               context;
+} split_rpc_request_t;
+
+typedef enum {
+    RPC_STAGE_INFO,
+    RPC_STAGE_REQ_DATA,
+    RPC_STAGE_EXECUTE,
+} rpc_stage_t;
+
+static split_rpc_request_t rpc_queue[SPLIT_RPC_QUEUE_SIZE];
+static uint8_t             rpc_queue_head        = 0;
+static uint8_t             rpc_queue_tail        = 0;
+static uint8_t             rpc_queue_count       = 0;
+static uint16_t            rpc_fragment          = 0;
+static uint8_t             rpc_failures          = 0;
+static rpc_stage_t         rpc_stage             = RPC_STAGE_INFO;
+static uint8_t             rpc_sequence          = 0;
+static uint8_t             rpc_fragment_sequence = 0;
+static bool                rpc_session_started   = false;
+
+// Zero is never handed out, so that a freshly started slave executes the first fragment it sees
+static uint8_t rpc_next_sequence(void) {
+    if (++rpc_sequence == 0) ++rpc_sequence;
+    return rpc_sequence;
+}
+
+static uint16_t rpc_fragment_count(const split_rpc_request_t *req) {
+    uint16_t m2s_fragments = (req->m2s_length + RPC_M2S_BUFFER_SIZE - 1) / RPC_M2S_BUFFER_SIZE;
+    uint16_t s2m_fragments = (req->s2m_length + RPC_S2M_BUFFER_SIZE - 1) / RPC_S2M_BUFFER_SIZE;
+    uint16_t count         = m2s_fragments > s2m_fragments ? m2s_fragments : s2m_fragments;
+    return count ? count : 1;
+}
+
+static uint8_t rpc_fragment_length(uint16_t total, uint16_t fragment, uint8_t fragment_size) {
+    uint32_t offset = (uint32_t)fragment * fragment_size;
+    if (offset >= total) return 0;
+    return (total - offset) < fragment_size ? (total - offset) : fragment_size;
+}
+
+static void rpc_async_complete(bool success) {
+    split_rpc_request_t req = rpc_queue[rpc_queue_tail];
+    rpc_queue_tail          = (rpc_queue_tail + 1) % SPLIT_RPC_QUEUE_SIZE;
+    --rpc_queue_count;
+    rpc_fragment          = 0;
+    rpc_failures          = 0;
+    rpc_stage             = RPC_STAGE_INFO;
+    rpc_fragment_sequence = 0;
+
+    if (req.callback) {
+        req.callback(req.transaction_id, success, req.context);
+    }
+}
+
+/**
+ * @brief Advances the oldest queued RPC by a single stage, so that only one
+ * short transaction (or the execute/response pair) happens per scan. Any
+ * failure restarts the fragment from the info stage on a later scan. Each
+ * fragment carries a sequence number, which the slave uses to skip an execute
+ * it has already run when only the acknowledgement or the response was lost.
+ *
+ * Only a single attempt is made per scan, and failures are not reported as
+ * link errors -- the RPC is abandoned after SPLIT_RPC_MAX_FAILURES consecutive
+ * failed attempts instead.
+ */
+static void rpc_async_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (rpc_queue_count == 0) return;
+
+    split_rpc_request_t *req        = &rpc_queue[rpc_queue_tail];
+    uint16_t             count      = rpc_fragment_count(req);
+    uint8_t              m2s_length = rpc_fragment_length(req->m2s_length, rpc_fragment, RPC_M2S_BUFFER_SIZE);
+    uint8_t              s2m_length = rpc_fragment_length(req->s2m_length, rpc_fragment, RPC_S2M_BUFFER_SIZE);
+    bool                 okay       = true;
+
+    switch (rpc_stage) {
+        case RPC_STAGE_INFO: {
+            if (rpc_fragment_sequence == 0) {
+                rpc_fragment_sequence = rpc_next_sequence();
+            }
+
+            rpc_sync_info_t info = {.payload = {.transaction_id = req->transaction_id, .m2s_length = m2s_length, .s2m_length = s2m_length, .fragment = rpc_fragment, .fragment_count = count, .sequence = rpc_fragment_sequence, .new_session = !rpc_session_started}};
+            info.checksum        = crc8(&info.payload, sizeof(info.payload));
+
+            split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = m2s_length;
+            split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = s2m_length;
+
+            okay = transport_write(PUT_RPC_INFO, &info, sizeof(info));
+            if (okay) {
+                rpc_session_started = true;
+                rpc_stage           = m2s_length ? RPC_STAGE_REQ_DATA : RPC_STAGE_EXECUTE;
+            }
+            break;
+        }
+        case RPC_STAGE_REQ_DATA:
+            okay = transport_write(PUT_RPC_REQ_DATA, req->m2s_buffer + (uint32_t)rpc_fragment * RPC_M2S_BUFFER_SIZE, m2s_length);
+            if (okay) {
+                rpc_stage = RPC_STAGE_EXECUTE;
+            }
+            break;
+        case RPC_STAGE_EXECUTE:
+            okay = transport_write(EXECUTE_RPC, &req->transaction_id, sizeof(req->transaction_id));
+            if (okay && s2m_length) {
+                okay = transport_read(GET_RPC_RESP_DATA, req->s2m_buffer + (uint32_t)rpc_fragment * RPC_S2M_BUFFER_SIZE, s2m_length);
+            }
+            if (okay) {
+                rpc_stage             = RPC_STAGE_INFO;
+                rpc_fragment_sequence = 0;
+                if (++rpc_fragment >= count) {
+                    rpc_async_complete(true);
+                }
+            }
+            break;
+    }
+
+    if (okay) {
+        rpc_failures = 0;
+    } else {
+        rpc_stage = RPC_STAGE_INFO;
+        if (++rpc_failures >= SPLIT_RPC_MAX_FAILURES) {
+            rpc_async_complete(false);
+        }
+    }
+}
+
+// Not wrapped in TRANSACTION_HANDLER_MASTER, the queue does its own retrying on later scans
+#    define TRANSACTIONS_RPC_ASYNC_MASTER() rpc_async_handlers_master(master_matrix, slave_matrix)
+
+#else // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#    define TRANSACTIONS_RPC_ASYNC_MASTER()
+
+#endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -760,6 +1213,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 
     // clang-format off
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
+    TRANSACTIONS_NODE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
     TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
@@ -772,9 +1226,11 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
+    TRANSACTIONS_OLED_BUFFER_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
     TRANSACTIONS_POINTING_REGISTRATIONS
     TRANSACTIONS_WATCHDOG_REGISTRATIONS
+    TRANSACTIONS_SYNC_STATES_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -799,13 +1255,20 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_RGB_MATRIX_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_OLED_BUFFER_MASTER();
     TRANSACTIONS_ST7565_MASTER();
     TRANSACTIONS_POINTING_MASTER();
     TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_SYNC_STATES_MASTER();
+    TRANSACTIONS_RPC_ASYNC_MASTER();
     return true;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_NODE_ID
+    // Extra nodes only provide their matrix
+    TRANSACTIONS_NODE_MATRIX_SLAVE();
+#else
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
@@ -819,9 +1282,12 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGB_MATRIX_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
+    TRANSACTIONS_OLED_BUFFER_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
     TRANSACTIONS_POINTING_SLAVE();
     TRANSACTIONS_WATCHDOG_SLAVE();
+    TRANSACTIONS_SYNC_STATES_SLAVE();
+#endif // SPLIT_NODE_ID
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -848,9 +1314,12 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
 
     // Prepare the metadata block
-    rpc_sync_info_t info = {.payload = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = target2initiator_buffer_size}};
+    rpc_sync_info_t info = {.payload = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = target2initiator_buffer_size, .fragment = 0, .fragment_count = 1, .sequence = rpc_next_sequence(), .new_session = !rpc_session_started}};
     info.checksum        = crc8(&info.payload, sizeof(info.payload));
 
+    // Any queued RPC in progress needs to resend its info block and request data
+    rpc_stage = RPC_STAGE_INFO;
+
     // Make sure the local side knows that we're not sending the full block of data
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = initiator2target_buffer_size;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = target2initiator_buffer_size;
@@ -863,6 +1332,7 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     if (!transport_write(PUT_RPC_INFO, &info, sizeof(info))) {
         return false;
     }
+    rpc_session_started = true;
     if (!transport_write(PUT_RPC_REQ_DATA, initiator2target_buffer, initiator2target_buffer_size)) {
         return false;
     }
@@ -875,6 +1345,45 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     return true;
 }
 
+bool transaction_rpc_exec_async(int8_t transaction_id, uint16_t initiator2target_buffer_size, const void *initiator2target_buffer, uint16_t target2initiator_buffer_size, void *target2initiator_buffer, split_rpc_callback_t callback, void *context) {
+    // Prevent transaction attempts while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    // Prevent overflowing the queue
+    if (rpc_queue_count >= SPLIT_RPC_QUEUE_SIZE) return false;
+
+    rpc_queue[rpc_queue_head] = (split_rpc_request_t){
+        .transaction_id = transaction_id,
+        .m2s_length     = initiator2target_buffer_size,
+        .m2s_buffer     = initiator2target_buffer,
+        .s2m_length     = target2initiator_buffer_size,
+        .s2m_buffer     = target2initiator_buffer,
+        .callback       = callback,
+        .context        = context,
+    };
+    rpc_queue_head = (rpc_queue_head + 1) % SPLIT_RPC_QUEUE_SIZE;
+    ++rpc_queue_count;
+    return true;
+}
+
+uint8_t transaction_rpc_async_pending(void) {
+    return rpc_queue_count;
+}
+
+uint16_t transaction_rpc_fragment(void) {
+    return split_shmem->rpc_info.payload.fragment;
+}
+
+uint16_t transaction_rpc_fragment_count(void) {
+    return split_shmem->rpc_info.payload.fragment_count;
+}
+
+// Sequence of the last fragment executed on the slave, see slave_rpc_exec_callback()
+static uint8_t rpc_last_sequence = 0;
+
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
     // The RPC info block contains the intended transaction ID, as well as the sizes for both inbound and outbound data.
     // Ignore the args -- the `split_shmem` already has the info, we just need to act upon it.
@@ -882,6 +1391,12 @@ void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *i
 
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = split_shmem->rpc_info.payload.m2s_length;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = split_shmem->rpc_info.payload.s2m_length;
+
+    // A (re)started master numbers its fragments from scratch, so forget the last one it ran before.
+    // Only the first info block of its session is flagged, retries of an executed fragment never are.
+    if (split_shmem->rpc_info.payload.new_session && crc8(&split_shmem->rpc_info.payload, sizeof(split_shmem->rpc_info.payload)) == split_shmem->rpc_info.checksum) {
+        rpc_last_sequence = 0;
+    }
 }
 
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
@@ -892,6 +1407,12 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
         return;
     }
 
+    // A retried fragment whose execute already ran only needs its response read back again
+    if (split_shmem->rpc_info.payload.sequence == rpc_last_sequence) {
+        return;
+    }
+    rpc_last_sequence = split_shmem->rpc_info.payload.sequence;
+
     int8_t transaction_id = split_shmem->rpc_info.payload.transaction_id;
     if (transaction_id < NUM_TOTAL_TRANSACTIONS) {
         split_transaction_desc_t *trans = &split_transaction_table[transaction_id];
@@ -45,9 +45,42 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+#ifdef SPLIT_EXTRA_NODES
+// reads the matrix of a single extra node, returns false if valid data was not received
+bool transactions_master_node(uint8_t node, matrix_row_t node_matrix[]);
+#endif // SPLIT_EXTRA_NODES
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+// Invoked on the master once a queued RPC has completed or failed
+typedef void (*split_rpc_callback_t)(int8_t transaction_id, bool success, void *context);
+
+// Queues an RPC that is processed one transaction per scan, fragmenting buffers larger than RPC_M2S_BUFFER_SIZE/RPC_S2M_BUFFER_SIZE.
+// Both buffers must stay valid until the callback has been invoked. Returns false if the request could not be queued.
+bool transaction_rpc_exec_async(int8_t transaction_id, uint16_t initiator2target_buffer_size, const void *initiator2target_buffer, uint16_t target2initiator_buffer_size, void *target2initiator_buffer, split_rpc_callback_t callback, void *context);
+
+#define transaction_rpc_send_async(transaction_id, initiator2target_buffer_size, initiator2target_buffer, callback, context) transaction_rpc_exec_async(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL, callback, context)
+#define transaction_rpc_recv_async(transaction_id, target2initiator_buffer_size, target2initiator_buffer, callback, context) transaction_rpc_exec_async(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer, callback, context)
+
+// Number of queued RPCs that have not completed yet
+uint8_t transaction_rpc_async_pending(void);
+
+// Slave side: fragment of the RPC currently being executed, the data offsets are
+// fragment * RPC_M2S_BUFFER_SIZE and fragment * RPC_S2M_BUFFER_SIZE respectively
+uint16_t transaction_rpc_fragment(void);
+uint16_t transaction_rpc_fragment_count(void);
+
+#if defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+// Local copies of the states declared with SPLIT_SYNC_STATE(); the sending side
+// writes them, the receiving side reads them.
+extern split_sync_states_t split_sync_states;
+
+// Invoked on the receiving side whenever a synced state has changed
+void split_sync_state_updated_kb(uint8_t state_id);
+void split_sync_state_updated_user(uint8_t state_id);
+#endif // defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
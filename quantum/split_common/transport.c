@@ -32,6 +32,10 @@
 #        define SLAVE_I2C_ADDRESS 0x32
 #    endif
 
+#    ifndef SPLIT_NODE_I2C_ADDRESS
+#        define SPLIT_NODE_I2C_ADDRESS(node) (SLAVE_I2C_ADDRESS + 2 * ((node) + 1))
+#    endif // SPLIT_NODE_I2C_ADDRESS
+
 #    include "i2c_master.h"
 #    include "i2c_slave.h"
 
@@ -44,10 +48,14 @@ void transport_master_init(void) {
     i2c_init();
 }
 void transport_slave_init(void) {
+#    ifdef SPLIT_NODE_ID
+    i2c_slave_init(SPLIT_NODE_I2C_ADDRESS((SPLIT_NODE_ID) - 1));
+#    else
     i2c_slave_init(SLAVE_I2C_ADDRESS);
+#    endif // SPLIT_NODE_ID
 }
 
-i2c_status_t transport_trigger_callback(int8_t id) {
+i2c_status_t transport_trigger_callback(uint8_t address, int8_t id) {
     // If there's no callback, indicate that we were successful
     if (!split_transaction_table[id].slave_callback) {
         return I2C_STATUS_SUCCESS;
@@ -56,28 +64,28 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     // Kick off the "callback executor", now that data has been written to the slave
     split_shmem->transaction_id     = id;
     split_transaction_desc_t *trans = &split_transaction_table[I2C_EXECUTE_CALLBACK];
-    return i2c_writeReg(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
+    return i2c_writeReg(address, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_execute_transaction_at(uint8_t address, int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
-        if ((status = i2c_writeReg(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
+        if ((status = i2c_writeReg(address, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
             return false;
         }
     }
 
     // If we need to execute a callback on the slave, do so
-    if ((status = transport_trigger_callback(id)) < 0) {
+    if ((status = transport_trigger_callback(address, id)) < 0) {
         return false;
     }
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
-        if ((status = i2c_readReg(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
+        if ((status = i2c_readReg(address, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
             return false;
         }
         memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
@@ -86,6 +94,16 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    return transport_execute_transaction_at(SLAVE_I2C_ADDRESS, id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+#    ifdef SPLIT_EXTRA_NODES
+bool transport_execute_node_transaction(uint8_t node, int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    return transport_execute_transaction_at(SPLIT_NODE_I2C_ADDRESS(node), id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+#    endif // SPLIT_EXTRA_NODES
+
 #else // USE_I2C
 
 #    include "serial.h"
@@ -31,6 +31,29 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_EXTRA_NODES
+#    ifndef USE_I2C
+#        error "SPLIT_EXTRA_NODES requires the I2C split transport"
+#    endif // USE_I2C
+#    ifndef SPLIT_EXTRA_NODE_ROWS
+#        error "SPLIT_EXTRA_NODES requires SPLIT_EXTRA_NODE_ROWS to be defined"
+#    endif // SPLIT_EXTRA_NODE_ROWS
+#    define SPLIT_EXTRA_ROWS ((SPLIT_EXTRA_NODES) * (SPLIT_EXTRA_NODE_ROWS))
+#else
+#    define SPLIT_EXTRA_ROWS 0
+#endif // SPLIT_EXTRA_NODES
+
+// Rows of each half; the rows of any extra nodes follow those of both halves
+#define SPLIT_ROWS_PER_HAND (((MATRIX_ROWS) - (SPLIT_EXTRA_ROWS)) / 2)
+#define SPLIT_NODE_ROW_OFFSET(node) (2 * SPLIT_ROWS_PER_HAND + (node) * (SPLIT_EXTRA_NODE_ROWS))
+
+// Rows scanned by this device
+#ifdef SPLIT_NODE_ID
+#    define SPLIT_LOCAL_ROWS (SPLIT_EXTRA_NODE_ROWS)
+#else
+#    define SPLIT_LOCAL_ROWS SPLIT_ROWS_PER_HAND
+#endif // SPLIT_NODE_ID
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +63,11 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_EXTRA_NODES
+// Same as transport_execute_transaction(), but addresses one of the extra nodes instead of the slave half
+bool transport_execute_node_transaction(uint8_t node, int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#endif // SPLIT_EXTRA_NODES
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -54,15 +82,23 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
-    matrix_row_t matrix[(MATRIX_ROWS) / 2];
+    matrix_row_t matrix[SPLIT_ROWS_PER_HAND];
 } split_slave_matrix_sync_t;
 
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
-    matrix_row_t matrix[(MATRIX_ROWS) / 2];
+    matrix_row_t matrix[SPLIT_ROWS_PER_HAND];
 } split_master_matrix_sync_t;
 #endif // SPLIT_TRANSPORT_MIRROR
 
+#ifdef SPLIT_EXTRA_NODES
+// Checksum and rows are read in a single transaction
+typedef struct _split_node_matrix_sync_t {
+    uint8_t      checksum;
+    matrix_row_t matrix[SPLIT_EXTRA_NODE_ROWS];
+} split_node_matrix_sync_t;
+#endif // SPLIT_EXTRA_NODES
+
 #ifdef ENCODER_ENABLE
 typedef struct _split_slave_encoder_sync_t {
     uint8_t checksum;
@@ -114,17 +150,119 @@ typedef struct _split_slave_pointing_sync_t {
 } split_slave_pointing_sync_t;
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+#    include "oled_driver.h"
+
+#    ifndef SPLIT_OLED_BUFFER_BLOCKS_PER_SCAN
+#        define SPLIT_OLED_BUFFER_BLOCKS_PER_SCAN 1
+#    endif // SPLIT_OLED_BUFFER_BLOCKS_PER_SCAN
+
+typedef struct _split_oled_block_t {
+    uint8_t block;
+    uint8_t data[OLED_BLOCK_SIZE];
+} split_oled_block_t;
+
+// Blocks received by the slave, waiting to be applied to the OLED buffer from the main loop
+typedef struct _split_oled_buffer_sync_t {
+    uint8_t            count;
+    split_oled_block_t blocks[SPLIT_OLED_BUFFER_BLOCKS_PER_SCAN];
+} split_oled_buffer_sync_t;
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 typedef struct _rpc_sync_info_t {
     uint8_t checksum;
     struct {
-        int8_t  transaction_id;
-        uint8_t m2s_length;
-        uint8_t s2m_length;
+        int8_t   transaction_id;
+        uint8_t  m2s_length;
+        uint8_t  s2m_length;
+        uint16_t fragment;
+        uint16_t fragment_count;
+        uint8_t  sequence;
+        bool     new_session;
     } payload;
 } rpc_sync_info_t;
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#if defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+#    if defined(SPLIT_SYNC_STATES_KB) && defined(SPLIT_SYNC_STATES_USER)
+#        define SPLIT_SYNC_STATES_ALL SPLIT_SYNC_STATES_KB SPLIT_SYNC_STATES_USER
+#    elif defined(SPLIT_SYNC_STATES_KB)
+#        define SPLIT_SYNC_STATES_ALL SPLIT_SYNC_STATES_KB
+#    else
+#        define SPLIT_SYNC_STATES_ALL SPLIT_SYNC_STATES_USER
+#    endif
+
+// Sync direction, used as the third argument of SPLIT_SYNC_STATE()
+enum split_sync_direction {
+    SPLIT_SYNC_M2S,
+    SPLIT_SYNC_S2M,
+};
+
+// Sync policy, used as the fourth argument of SPLIT_SYNC_STATE()
+enum split_sync_policy {
+    SPLIT_SYNC_ON_CHANGE, // sent on the next scan after it changes
+    SPLIT_SYNC_THROTTLED, // sent at most every SPLIT_SYNC_THROTTLE_MS
+};
+
+// Helpers to only emit tokens for states of the given direction
+#    define SPLIT_SYNC_IF_M2S_SPLIT_SYNC_M2S(...) __VA_ARGS__
+#    define SPLIT_SYNC_IF_M2S_SPLIT_SYNC_S2M(...)
+#    define SPLIT_SYNC_IF_S2M_SPLIT_SYNC_M2S(...)
+#    define SPLIT_SYNC_IF_S2M_SPLIT_SYNC_S2M(...) __VA_ARGS__
+
+// clang-format off
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) SPLIT_SYNC_ID_##name,
+enum split_sync_state_id { SPLIT_SYNC_STATES_ALL NUM_SPLIT_SYNC_STATES };
+#    undef SPLIT_SYNC_STATE
+
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) SPLIT_SYNC_IF_M2S_##direction(SPLIT_SYNC_M2S_COUNT_##name,)
+enum { SPLIT_SYNC_STATES_ALL NUM_SPLIT_SYNC_M2S_STATES };
+#    undef SPLIT_SYNC_STATE
+
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) SPLIT_SYNC_IF_S2M_##direction(SPLIT_SYNC_S2M_COUNT_##name,)
+enum { SPLIT_SYNC_STATES_ALL NUM_SPLIT_SYNC_S2M_STATES };
+#    undef SPLIT_SYNC_STATE
+
+// Local copy of every registered state, as read and written by keyboard/user code
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) type name;
+typedef struct _split_sync_states_t {
+    SPLIT_SYNC_STATES_ALL
+} split_sync_states_t;
+#    undef SPLIT_SYNC_STATE
+
+// Batched master to slave states, sent as a single transaction
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) SPLIT_SYNC_IF_M2S_##direction(type name;)
+typedef struct _split_sync_m2s_data_t {
+    SPLIT_SYNC_STATES_ALL
+} split_sync_m2s_data_t;
+#    undef SPLIT_SYNC_STATE
+
+// Batched slave to master states, retrieved only when the checksum changes
+#    define SPLIT_SYNC_STATE(name, type, direction, policy) SPLIT_SYNC_IF_S2M_##direction(type name;)
+typedef struct _split_sync_s2m_data_t {
+    SPLIT_SYNC_STATES_ALL
+} split_sync_s2m_data_t;
+#    undef SPLIT_SYNC_STATE
+// clang-format on
+
+// Each batch carries the layout hash of the sending side's table, see transactions.c
+typedef struct _split_sync_m2s_t {
+    uint16_t              layout;
+    split_sync_m2s_data_t data;
+} split_sync_m2s_t;
+
+typedef struct _split_sync_s2m_batch_t {
+    uint16_t              layout;
+    split_sync_s2m_data_t data;
+} split_sync_s2m_batch_t;
+
+typedef struct _split_sync_s2m_t {
+    uint8_t                checksum;
+    split_sync_s2m_batch_t batch;
+} split_sync_s2m_t;
+#endif // defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -132,6 +270,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_EXTRA_NODES
+    split_node_matrix_sync_t nmatrix;
+#endif // SPLIT_EXTRA_NODES
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -184,6 +326,12 @@ typedef struct _split_shared_memory_t {
     uint8_t current_st7565_state;
 #endif // ST7565_ENABLE(OLED_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+    split_oled_block_t       oled_block;
+    bool                     oled_block_accepted;
+    split_oled_buffer_sync_t oled_staged;
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_BUFFER_ENABLE)
+
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
     split_slave_pointing_sync_t pointing;
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
@@ -197,6 +345,11 @@ typedef struct _split_shared_memory_t {
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#if defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
+    split_sync_m2s_t sync_m2s;
+    split_sync_s2m_t sync_s2m;
+#endif // defined(SPLIT_SYNC_STATES_KB) || defined(SPLIT_SYNC_STATES_USER)
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
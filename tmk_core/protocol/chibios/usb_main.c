@@ -1121,6 +1121,19 @@ void send_midi_packet(MIDI_EventPacket_t *event) {
     chnWrite(&drivers.midi_driver.driver, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
 }
 
+uint8_t send_midi_packets(MIDI_EventPacket_t *events, uint8_t count) {
+    // the output queue packs the packets into full endpoint transfers, flushing what is left on the next start of frame
+    size_t written = chnWriteTimeout(&drivers.midi_driver.driver, (uint8_t *)events, count * sizeof(MIDI_EventPacket_t), TIME_IMMEDIATE);
+
+    // the queue's buffers are a multiple of the packet size, so a packet is never split; but should it be, complete it
+    if (written % sizeof(MIDI_EventPacket_t)) {
+        size_t rest = sizeof(MIDI_EventPacket_t) - (written % sizeof(MIDI_EventPacket_t));
+        chnWrite(&drivers.midi_driver.driver, (uint8_t *)events + written, rest);
+        written += rest;
+    }
+    return written / sizeof(MIDI_EventPacket_t);
+}
+
 bool recv_midi_packet(MIDI_EventPacket_t *const event) {
     size_t size = chnReadTimeout(&drivers.midi_driver.driver, (uint8_t *)event, sizeof(MIDI_EventPacket_t), TIME_IMMEDIATE);
     return size == sizeof(MIDI_EventPacket_t);
@@ -714,6 +714,28 @@ void send_midi_packet(MIDI_EventPacket_t *event) {
     MIDI_Device_SendEventPacket(&USB_MIDI_Interface, event);
 }
 
+uint8_t send_midi_packets(MIDI_EventPacket_t *events, uint8_t count) {
+    if (USB_DeviceState != DEVICE_STATE_Configured) {
+        return count;
+    }
+
+    uint8_t ep   = Endpoint_GetCurrentEndpoint();
+    uint8_t sent = 0;
+    Endpoint_SelectEndpoint(USB_MIDI_Interface.Config.DataINEndpoint.Address);
+
+    // fill the bank with as many packets as fit, then send them in a single transfer
+    if (Endpoint_IsINReady()) {
+        while (sent < count && Endpoint_IsReadWriteAllowed()) {
+            Endpoint_Write_Stream_LE(&events[sent], sizeof(MIDI_EventPacket_t), NULL);
+            sent++;
+        }
+        Endpoint_ClearIN();
+    }
+
+    Endpoint_SelectEndpoint(ep);
+    return sent;
+}
+
 bool recv_midi_packet(MIDI_EventPacket_t *const event) {
     return MIDI_Device_ReceiveEventPacket(&USB_MIDI_Interface, event);
 }
@@ -1,9 +1,16 @@
 #include <LUFA/Drivers/USB/USB.h>
+#include <string.h>
 #include "qmk_midi.h"
 #include "sysex_tools.h"
 #include "midi.h"
 #include "usb_descriptor.h"
 #include "process_midi.h"
+#ifdef SEQUENCER_ENABLE
+#    include "sequencer.h"
+#endif
+#ifdef PROTOCOL_CHIBIOS
+#    include <ch.h>
+#endif
 
 /*******************************************************************************
  * MIDI
@@ -20,11 +27,86 @@ MidiDevice midi_device;
 #define SYS_COMMON_2 0x20
 #define SYS_COMMON_3 0x30
 
-static void usb_send_func(MidiDevice* device, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
-    MIDI_EventPacket_t event;
-    event.Data1 = byte0;
-    event.Data2 = byte1;
-    event.Data3 = byte2;
+/* Outgoing packets are queued, and handed over to the USB stack once per
+ * main loop iteration by 'midi_tx_task': everything sent in the meantime -
+ * e.g. a chord, or a fast arpeggio - goes out coalesced into full endpoint
+ * transfers, without waiting for the host to fetch each packet on its own.
+ *
+ * On ChibiOS, 'midi_queue_i' also queues packets from virtual timer callbacks:
+ * the main loop appends to the queue under the system lock, and only ever
+ * removes from it.
+ */
+#ifndef MIDI_TX_BUFFER_SIZE
+#    define MIDI_TX_BUFFER_SIZE 32
+#endif
+_Static_assert((MIDI_TX_BUFFER_SIZE & (MIDI_TX_BUFFER_SIZE - 1)) == 0 && MIDI_TX_BUFFER_SIZE <= 128, "MIDI_TX_BUFFER_SIZE must be a power of two, up to 128");
+
+static MIDI_EventPacket_t tx_buffer[MIDI_TX_BUFFER_SIZE];
+static volatile uint8_t   tx_head = 0;
+static uint8_t            tx_tail = 0;
+
+// a sysex message being streamed by 'midi_send_sysex'
+static const uint8_t* sysex_data      = NULL;
+static uint16_t       sysex_remaining = 0;
+
+static inline uint8_t tx_count(void) {
+    return (uint8_t)(tx_head - tx_tail);
+}
+
+/**
+ * Hand as many queued packets to the USB stack as it takes without blocking.
+ */
+static void tx_flush(void) {
+    while (tx_count()) {
+        uint8_t index = tx_tail & (MIDI_TX_BUFFER_SIZE - 1);
+        uint8_t count = MIDI_TX_BUFFER_SIZE - index; // up to the end of the ring
+        if (count > tx_count()) {
+            count = tx_count();
+        }
+
+        uint8_t sent = send_midi_packets(&tx_buffer[index], count);
+        tx_tail += sent;
+        if (sent < count) {
+            return;
+        }
+    }
+}
+
+static bool tx_append(MIDI_EventPacket_t* event) {
+    if (tx_count() == MIDI_TX_BUFFER_SIZE) {
+        return false;
+    }
+    tx_buffer[tx_head & (MIDI_TX_BUFFER_SIZE - 1)] = *event;
+    tx_head++;
+    return true;
+}
+
+static void tx_push(MIDI_EventPacket_t* event) {
+    while (true) {
+#ifdef PROTOCOL_CHIBIOS
+        chSysLock();
+        bool queued = tx_append(event);
+        chSysUnlock();
+#else
+        bool queued = tx_append(event);
+#endif
+        if (queued) {
+            return;
+        }
+
+        tx_flush();
+        if (tx_count() == MIDI_TX_BUFFER_SIZE) {
+            // the host is not keeping up: rather wait, than lose e.g. a note off
+            send_midi_packet(&tx_buffer[tx_tail & (MIDI_TX_BUFFER_SIZE - 1)]);
+            tx_tail++;
+        }
+    }
+}
+
+static bool usb_build_packet(MIDI_EventPacket_t* event, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    event->Data1 = byte0;
+    event->Data2 = byte1;
+    event->Data3 = byte2;
 
     uint8_t cable = 0;
 
@@ -33,43 +115,111 @@ static void usb_send_func(MidiDevice* device, uint16_t cnt, uint8_t byte0, uint8
         switch (cnt) {
             case 3:
                 if (byte2 == SYSEX_END)
-                    event.Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_3);
+                    event->Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_3);
                 else
-                    event.Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
+                    event->Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
                 break;
             case 2:
                 if (byte1 == SYSEX_END)
-                    event.Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_2);
+                    event->Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_2);
                 else
-                    event.Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
+                    event->Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
                 break;
             case 1:
                 if (byte0 == SYSEX_END)
-                    event.Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_1);
+                    event->Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_1);
                 else
-                    event.Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
+                    event->Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
                 break;
             default:
-                return; // invalid cnt
+                return false; // invalid cnt
         }
     } else {
         // deal with 'system common' messages
         // TODO are there any more?
         switch (byte0 & 0xF0) {
             case MIDI_SONGPOSITION:
-                event.Event = MIDI_EVENT(cable, SYS_COMMON_3);
+                event->Event = MIDI_EVENT(cable, SYS_COMMON_3);
                 break;
             case MIDI_SONGSELECT:
             case MIDI_TC_QUARTERFRAME:
-                event.Event = MIDI_EVENT(cable, SYS_COMMON_2);
+                event->Event = MIDI_EVENT(cable, SYS_COMMON_2);
                 break;
             default:
-                event.Event = MIDI_EVENT(cable, byte0);
+                event->Event = MIDI_EVENT(cable, byte0);
                 break;
         }
     }
+    return true;
+}
+
+/**
+ * Queue the next chunks of the sysex message being streamed, as long as there is room.
+ *
+ * @param[in] all queue the whole rest of the message, waiting for the host if need be
+ */
+static void sysex_feed(bool all) {
+    while (sysex_remaining && (all || tx_count() < MIDI_TX_BUFFER_SIZE)) {
+        MIDI_EventPacket_t event;
+        uint8_t            b[3] = {0, 0, 0};
+        uint8_t            cnt  = sysex_remaining > 3 ? 3 : sysex_remaining;
 
-    send_midi_packet(&event);
+        memcpy(b, sysex_data, cnt);
+        if (usb_build_packet(&event, cnt, b[0], b[1], b[2])) {
+            tx_push(&event);
+        }
+        // only once queued, for 'midi_queue_i' not to slip anything in before the end of the message
+        sysex_data += cnt;
+        sysex_remaining -= cnt;
+    }
+}
+
+static void usb_send_func(MidiDevice* device, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    MIDI_EventPacket_t event;
+    if (!usb_build_packet(&event, cnt, byte0, byte1, byte2)) {
+        return;
+    }
+
+    // realtime messages may go in between the packets of a sysex message, anything else ends it
+    if (sysex_remaining && !midi_is_realtime(byte0)) {
+        sysex_feed(true);
+    }
+    tx_push(&event);
+}
+
+bool midi_send_sysex(const uint8_t* data, uint16_t length) {
+    if (sysex_remaining) {
+        return false;
+    }
+    sysex_data      = data;
+    sysex_remaining = length;
+    sysex_feed(false);
+    return true;
+}
+
+bool midi_sysex_pending(void) {
+    return sysex_remaining != 0;
+}
+
+#ifdef PROTOCOL_CHIBIOS
+bool midi_queue_i(uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    MIDI_EventPacket_t event;
+    if (!usb_build_packet(&event, cnt, byte0, byte1, byte2)) {
+        return false;
+    }
+
+    // nothing may wait for the sysex message to end from here
+    if (sysex_remaining && !midi_is_realtime(byte0)) {
+        return false;
+    }
+    return tx_append(&event);
+}
+#endif
+
+void midi_tx_task(void) {
+    tx_flush();
+    sysex_feed(false);
+    tx_flush();
 }
 
 static void usb_get_midi(MidiDevice* device) {
@@ -116,6 +266,14 @@ static void fallthrough_callback(MidiDevice* device, uint16_t cnt, uint8_t byte0
 #endif
 }
 
+#ifdef SEQUENCER_ENABLE
+static void realtime_callback(MidiDevice* device, uint8_t byte) {
+    sequencer_process_midi_realtime(byte);
+    // registering this callback keeps realtime messages from the fallthrough callback
+    fallthrough_callback(device, 1, byte, 0, 0);
+}
+#endif
+
 static void cc_callback(MidiDevice* device, uint8_t chan, uint8_t num, uint8_t val) {
     // sending it back on the next channel
     // midi_send_cc(device, (chan + 1) % 16, num, val);
@@ -132,4 +290,7 @@ void setup_midi(void) {
     midi_device_set_pre_input_process_func(&midi_device, usb_get_midi);
     midi_register_fallthrough_callback(&midi_device, fallthrough_callback);
     midi_register_cc_callback(&midi_device, cc_callback);
+#ifdef SEQUENCER_ENABLE
+    midi_register_realtime_callback(&midi_device, realtime_callback);
+#endif
 }
@@ -6,5 +6,35 @@
 extern MidiDevice midi_device;
 void              setup_midi(void);
 void              send_midi_packet(MIDI_EventPacket_t* event);
+uint8_t           send_midi_packets(MIDI_EventPacket_t* events, uint8_t count);
 bool              recv_midi_packet(MIDI_EventPacket_t* const event);
+
+/**
+ * @brief Send outgoing packets queued since the last call; called from the main loop.
+ */
+void midi_tx_task(void);
+
+/**
+ * @brief Stream a complete sysex message, from SYSEX_BEGIN to SYSEX_END.
+ *
+ * @details the message is sent in the background by 'midi_tx_task', so it
+ *          may be longer than the transmit buffer - 'data' has to stay valid
+ *          until 'midi_sysex_pending' returns false. Realtime messages, like
+ *          the MIDI clock, are sent in between; any other message waits for
+ *          the sysex to end.
+ * @return false if another sysex message is still being sent
+ */
+bool midi_send_sysex(const uint8_t* data, uint16_t length);
+bool midi_sysex_pending(void);
+
+#    ifdef PROTOCOL_CHIBIOS
+/**
+ * @brief Queue a message from a locked context, e.g. a virtual timer callback.
+ *
+ * @details it is sent by the next 'midi_tx_task', like the others.
+ * @return false if the message has to wait: the transmit buffer is full, or a
+ *         message other than a realtime one would end a sysex message early
+ */
+bool midi_queue_i(uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2);
+#    endif
 #endif